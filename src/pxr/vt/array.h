@@ -65,13 +65,13 @@ public:
         : _shapeData { 0 }, _foreignSource(foreignSrc) {}
 
     Vt_ArrayBase(Vt_ArrayBase const &other) = default;
-    Vt_ArrayBase(Vt_ArrayBase &&other) : Vt_ArrayBase(other) {
+    Vt_ArrayBase(Vt_ArrayBase &&other) noexcept : Vt_ArrayBase(other) {
         other._shapeData.clear();
         other._foreignSource = nullptr;
     }
 
     Vt_ArrayBase &operator=(Vt_ArrayBase const &other) = default;
-    Vt_ArrayBase &operator=(Vt_ArrayBase &&other) {
+    Vt_ArrayBase &operator=(Vt_ArrayBase &&other) noexcept {
         if (this == &other)
             return *this;
         *this = other;
@@ -293,7 +293,7 @@ ARCH_PRAGMA_POP
     
     /// Move from \p other.  The new array takes ownership of \p other's
     /// underlying data.
-    VtArray(VtArray &&other) : Vt_ArrayBase(std::move(other))
+    VtArray(VtArray &&other) noexcept : Vt_ArrayBase(std::move(other))
                              , _data(other._data) {
         other._data = nullptr;
     }
@@ -328,7 +328,7 @@ ARCH_PRAGMA_POP
 
     /// Move assign from \p other.  This array takes ownership of \p other's
     /// underlying data.
-    VtArray &operator=(VtArray &&other) {
+    VtArray &operator=(VtArray &&other) noexcept {
         if (this == &other)
             return *this;
         _DecRef();
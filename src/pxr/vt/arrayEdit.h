@@ -19,13 +19,28 @@
 
 #include <pxr/tf/diagnostic.h>
 #include <pxr/tf/hash.h>
+#include <pxr/tf/span.h>
 #include <pxr/trace/trace.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 VT_NAMESPACE_OPEN_SCOPE
 
 template <class ELEM>
 class VtArrayEditBuilder; // fwd
 
+template <class ELEM>
+class VtArrayEditPlan; // fwd
+
+template <class ELEM>
+class VtArrayEditView; // fwd
+
 /// \class VtArrayEdit
 ///
 /// An array edit represents either a sequence of per-element modifications to a
@@ -42,7 +57,9 @@ class VtArrayEditBuilder; // fwd
 /// (which represents no edits) is the identity element.
 ///
 /// See the associated VtArrayEditBuilder class to understand the available edit
-/// operations, and to build a VtArrayEdit from them.
+/// operations, and to build a VtArrayEdit from them.  To apply the same edit to
+/// many arrays of the same size, see VtArrayEditPlan.  To read a few elements
+/// of an edited array without materializing it, see VtArrayEditView.
 ///
 template <class ELEM>
 class VtArrayEdit
@@ -188,9 +205,27 @@ public:
         }        
         return _ComposeEdits(std::move(weaker));
     }
+
+    /// Compose a stack of \p edits, ordered from strongest to weakest, and
+    /// return the result.  This is equivalent to composing each edit over the
+    /// composition of the edits weaker than it with ComposeOver(), but
+    /// allocates the combined literals and instructions only once rather than
+    /// once per edit.  Edits weaker than the strongest dense array in the
+    /// stack have no effect and are not examined.
+    static VtArrayEdit ComposeStack(TfSpan<const VtArrayEdit> edits);
+
+    /// Apply this edit to \p array and return the result, as
+    /// ComposeOver(array).GetDenseArray() does.  If \p inverse is not null,
+    /// also set it to an edit that restores \p array when composed over the
+    /// result.  Unless this edit is a dense array, the inverse only holds the
+    /// elements of \p array that this edit overwrites or erases, so it is
+    /// proportional in size to this edit rather than to \p array.
+    Array ApplyWithInverse(Array const &array, VtArrayEdit *inverse) const;
     
 private:
     friend class VtArrayEditBuilder<ELEM>;
+    friend class VtArrayEditPlan<ELEM>;
+    friend class VtArrayEditView<ELEM>;
 
     template <class HashState>
     friend void TfHashAppend(HashState &h, VtArrayEdit const &self) {
@@ -204,6 +239,13 @@ private:
         return _ApplyEdits(Array {weaker});
     }
 
+    static Array _BuildFromRuns(Array const &weaker, Array const &literals,
+                                std::vector<_Ops::Run> const &runs);
+
+    static VtArrayEdit _InvertRuns(Array const &weaker, size_t resultSize,
+                                   std::vector<_Ops::Run> const &runs);
+    VtArrayEdit _InvertWritesAndResizes(Array const &weaker) const;
+
     VtArrayEdit _ComposeEdits(VtArrayEdit &&weaker) &&;
     VtArrayEdit _ComposeEdits(VtArrayEdit const &weaker) &&;
     
@@ -239,14 +281,46 @@ VtArrayEdit<ELEM>::_ApplyEdits(Array &&weaker) const
     Array const &literals = _denseOrLiterals;
     const auto numLiterals = literals.size();
 
-    // XXX: Note that this does not handle certain sequences of inserts and
-    // erases (specifically those that insert or erase contiguous ranges of
-    // elements) optimally.  This could be improved by detecting these cases and
-    // doing a single batch insert or erase instead, to minimize shuffling the
-    // other elements.
-    
+    // Inserts and erases shift all the elements that follow them, so applying
+    // K of them one by one to an N-element array costs O(N*K).  Instead,
+    // compute the final layout as runs of input elements and literals, and
+    // build the result in one pass.  Otherwise only writes and resizes
+    // remain, which are cheapest done in place.
+    if (_ops.HasInsertOrErase()) {
+        return _BuildFromRuns(
+            cresult, literals, _ops.ComputeRuns(numLiterals, cresult.size()));
+    }
+
+    // Large edits that only write elements are applied in parallel, with
+    // each task applying the writes to one partition of the array in order.
+    // Partitioning costs about as much as applying the writes serially, so
+    // this only pays off with more than one thread.
+    constexpr size_t minParallelWrites = 32768;
+    std::vector<_Ops::Write> writes;
+    std::vector<size_t> partitionEnds;
+    if (tbb::this_task_arena::max_concurrency() > 1 &&
+        _ops.PartitionWrites(numLiterals, cresult.size(), minParallelWrites,
+                             &writes, &partitionEnds)) {
+        ELEM *data = result.data();
+        ELEM const *literalData = literals.cdata();
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, partitionEnds.size()),
+            [&](tbb::blocked_range<size_t> const &r) {
+                for (size_t p = r.begin(); p != r.end(); ++p) {
+                    const size_t end = partitionEnds[p];
+                    for (size_t i = p ? partitionEnds[p - 1] : 0;
+                         i != end; ++i) {
+                        _Ops::Write const &w = writes[i];
+                        data[w.dst] =
+                            w.isLiteral ? literalData[w.src] : data[w.src];
+                    }
+                }
+            });
+        return result;
+    }
+
     _ops.ForEachValid(numLiterals, cresult.size(),
-    [&](_Ops::Op op, int64_t a1, int64_t a2) {
+    [&](_Ops::Op op, int64_t a1, int64_t a2, int64_t a3) {
         switch (op) {
         case _Ops::OpWriteLiteral:
             result[a2] = literals[a1];
@@ -284,11 +358,305 @@ VtArrayEdit<ELEM>::_ApplyEdits(Array &&weaker) const
                 result.resize(a1);
             }
             break;
+        case _Ops::OpWriteLiteralRange: // a1: literal index -> a2: result
+                                        // index, a3: count.
+            std::copy_n(literals.cdata() + a1, a3, result.data() + a2);
+            break;
+        case _Ops::OpWriteRefRange: { // a1: result index -> a2: result index,
+                                      // a3: count.
+            // Overlapping ranges copy as if through a temporary.
+            ELEM *data = result.data();
+            if (a1 >= a2) {
+                std::copy_n(data + a1, a3, data + a2);
+            }
+            else {
+                std::copy_backward(data + a1, data + a1 + a3, data + a2 + a3);
+            }
+            break;
+        }
+        case _Ops::OpInsertLiteralRange:
+        case _Ops::OpInsertRefRange:
+        case _Ops::OpEraseRange:
+            // Handled by _BuildFromRuns() above.
+            break;
         };
     });
     return result;
 }
 
+template <class ELEM>
+VtArray<ELEM>
+VtArrayEdit<ELEM>::_BuildFromRuns(
+    Array const &weaker, Array const &literals,
+    std::vector<_Ops::Run> const &runs)
+{
+    TRACE_FUNCTION();
+
+    size_t size = 0;
+    for (_Ops::Run const &run: runs) {
+        size += run.count;
+    }
+
+    Array result;
+    result.resize(size, [&](ELEM *out, ELEM *) {
+        ELEM const *src = weaker.cdata();
+        for (_Ops::Run const &run: runs) {
+            switch (run.kind) {
+            case _Ops::Run::Source:
+                out = std::uninitialized_copy_n(
+                    src + run.index, run.count, out);
+                break;
+            case _Ops::Run::Literal:
+                out = std::uninitialized_fill_n(
+                    out, run.count, literals[run.index]);
+                break;
+            case _Ops::Run::Default:
+                out = std::uninitialized_fill_n(out, run.count, ELEM());
+                break;
+            case _Ops::Run::Literals:
+                out = std::uninitialized_copy_n(
+                    literals.cdata() + run.index, run.count, out);
+                break;
+            };
+        }
+    });
+    return result;
+}
+
+template <class ELEM>
+VtArray<ELEM>
+VtArrayEdit<ELEM>::ApplyWithInverse(
+    Array const &array, VtArrayEdit *inverse) const
+{
+    TRACE_FUNCTION();
+
+    if (IsDenseArray()) {
+        if (inverse) {
+            *inverse = array;
+        }
+        return _denseOrLiterals;
+    }
+    if (!inverse) {
+        return _ApplyEdits(array);
+    }
+
+    // Compute the inverse before assigning it, since inverse may be this.
+    Array result;
+    VtArrayEdit inv;
+    if (_ops.HasInsertOrErase()) {
+        const std::vector<_Ops::Run> runs =
+            _ops.ComputeRuns(_denseOrLiterals.size(), array.size());
+        result = _BuildFromRuns(array, _denseOrLiterals, runs);
+        inv = _InvertRuns(array, result.size(), runs);
+    }
+    else {
+        // Writes and resizes are cheapest applied in place, without building
+        // the result from runs, and the inverse only needs the elements they
+        // overwrite or drop, so find those directly.
+        inv = _InvertWritesAndResizes(array);
+        result = _ApplyEdits(array);
+    }
+    *inverse = std::move(inv);
+    return result;
+}
+
+template <class ELEM>
+VtArrayEdit<ELEM>
+VtArrayEdit<ELEM>::_InvertRuns(
+    Array const &weaker, size_t resultSize,
+    std::vector<_Ops::Run> const &runs)
+{
+    TRACE_FUNCTION();
+
+    // Find ranges of weaker's elements that appear in order in the result.
+    // Copies that reorder or repeat input elements are treated as new
+    // elements.
+    struct _Kept {
+        int64_t in;
+        int64_t out;
+        int64_t count;
+    };
+    std::vector<_Kept> kept;
+    int64_t out = 0, inEnd = 0;
+    for (_Ops::Run const &run: runs) {
+        if (run.kind == _Ops::Run::Source) {
+            const int64_t skip = std::max<int64_t>(inEnd - run.index, 0);
+            if (skip < run.count) {
+                kept.push_back({ run.index + skip, out + skip,
+                                 run.count - skip });
+                inEnd = run.index + run.count;
+            }
+        }
+        out += run.count;
+    }
+
+    // Restore the gap after each kept range, from back to front so that the
+    // result indexes of the gaps before it still hold.  Overwrite as much of
+    // each gap as possible, then erase or insert the difference.
+    VtArrayEditBuilder<ELEM> builder;
+    ELEM const *src = weaker.cdata();
+    int64_t nextIn = weaker.size();
+    int64_t nextOut = resultSize;
+    for (size_t i = kept.size() + 1; i--; ) {
+        const int64_t in = i ? kept[i - 1].in + kept[i - 1].count : 0;
+        const int64_t outBegin = i ? kept[i - 1].out + kept[i - 1].count : 0;
+        const int64_t numIn = nextIn - in;
+        const int64_t numOut = nextOut - outBegin;
+        const int64_t numWrite = std::min(numIn, numOut);
+        if (numWrite) {
+            builder.WriteRange(
+                TfSpan<const ELEM>(src + in, numWrite), outBegin);
+        }
+        if (numOut > numWrite) {
+            builder.EraseRange(outBegin + numWrite, numOut - numWrite);
+        }
+        else if (numIn > numWrite) {
+            builder.InsertRange(
+                TfSpan<const ELEM>(src + in + numWrite, numIn - numWrite),
+                i == kept.size() ? _Ops::EndIndex : nextOut);
+        }
+        if (i) {
+            nextIn = kept[i - 1].in;
+            nextOut = kept[i - 1].out;
+        }
+    }
+    return builder.FinalizeAndReset();
+}
+
+template <class ELEM>
+VtArrayEdit<ELEM>
+VtArrayEdit<ELEM>::_InvertWritesAndResizes(Array const &weaker) const
+{
+    TRACE_FUNCTION();
+
+    // Track the size of the array, and how many of weaker's leading elements
+    // no resize has dropped.  Note writes to those elements.
+    const int64_t weakerSize = weaker.size();
+    int64_t size = weakerSize;
+    int64_t keepSize = weakerSize;
+    std::vector<int64_t> written;
+    _ops.ForEachValid(_denseOrLiterals.size(), weakerSize,
+    [&](_Ops::Op op, int64_t a1, int64_t a2, int64_t a3) {
+        switch (op) {
+        case _Ops::OpWriteLiteral:
+        case _Ops::OpWriteRef:
+            if (a2 < keepSize) {
+                written.push_back(a2);
+            }
+            break;
+        case _Ops::OpWriteLiteralRange:
+        case _Ops::OpWriteRefRange:
+            for (int64_t j = a2, end = std::min(a2 + a3, keepSize);
+                 j < end; ++j) {
+                written.push_back(j);
+            }
+            break;
+        case _Ops::OpMinSize:
+        case _Ops::OpMinSizeFill:
+            size = std::max(size, a1);
+            break;
+        case _Ops::OpSetSize:
+        case _Ops::OpSetSizeFill:
+            size = a1;
+            break;
+        case _Ops::OpMaxSize:
+            size = std::min(size, a1);
+            break;
+        default:
+            break;
+        };
+        keepSize = std::min(keepSize, size);
+    });
+
+    std::sort(written.begin(), written.end());
+    written.erase(std::unique(written.begin(), written.end()), written.end());
+    written.erase(std::lower_bound(written.begin(), written.end(), keepSize),
+                  written.end());
+
+    VtArrayEditBuilder<ELEM> builder;
+    Array elems;
+    elems.reserve(written.size());
+    for (int64_t index: written) {
+        elems.push_back(weaker[index]);
+    }
+    builder.WriteMany(elems, written);
+
+    // Restore the elements that resizes dropped and the original size.
+    ELEM const *src = weaker.cdata();
+    const int64_t numRewrite = std::min(size, weakerSize) - keepSize;
+    if (numRewrite > 0) {
+        builder.WriteRange(
+            TfSpan<const ELEM>(src + keepSize, numRewrite), keepSize);
+    }
+    if (size > weakerSize) {
+        builder.SetSize(weakerSize);
+    }
+    else if (size < weakerSize) {
+        builder.InsertRange(
+            TfSpan<const ELEM>(src + size, weakerSize - size),
+            _Ops::EndIndex);
+    }
+    return builder.FinalizeAndReset();
+}
+
+template <class ELEM>
+VtArrayEdit<ELEM>
+VtArrayEdit<ELEM>::ComposeStack(TfSpan<const VtArrayEdit> edits)
+{
+    TRACE_FUNCTION();
+
+    // Find the strongest dense array, if any.  Nothing weaker matters.
+    size_t denseIndex = 0;
+    while (denseIndex != static_cast<size_t>(edits.size()) &&
+           !edits[denseIndex].IsDenseArray()) {
+        ++denseIndex;
+    }
+    VtArrayEdit const *dense =
+        denseIndex != static_cast<size_t>(edits.size()) ?
+        &edits[denseIndex] : nullptr;
+
+    // Collect the edits to compose, weakest first.
+    std::vector<VtArrayEdit const *> toCompose;
+    size_t numLiterals = 0;
+    size_t numIns = 0;
+    for (size_t i = denseIndex; i--; ) {
+        if (!edits[i].IsIdentity()) {
+            toCompose.push_back(&edits[i]);
+            numLiterals += edits[i]._denseOrLiterals.size();
+            numIns += edits[i]._ops._ins.size();
+        }
+    }
+
+    if (toCompose.empty()) {
+        return dense ? *dense : VtArrayEdit {};
+    }
+    if (toCompose.size() == 1) {
+        return dense ? toCompose[0]->ComposeOver(*dense) : *toCompose[0];
+    }
+
+    // Concatenate all the literals and ops, offsetting the literal indexes.
+    VtArrayEdit result;
+    result._denseOrLiterals.resize(
+        numLiterals, [&toCompose](ELEM *out, ELEM *) {
+            for (VtArrayEdit const *edit: toCompose) {
+                out = std::uninitialized_copy(
+                    edit->_denseOrLiterals.cbegin(),
+                    edit->_denseOrLiterals.cend(), out);
+            }
+        });
+    result._ops._ins.reserve(numIns);
+    int64_t literalOffset = 0;
+    for (VtArrayEdit const *edit: toCompose) {
+        result._ops.Append(edit->_ops, literalOffset);
+        literalOffset += edit->_denseOrLiterals.size();
+    }
+
+    if (dense) {
+        return result._ApplyEdits(dense->_denseOrLiterals);
+    }
+    return VtArrayEditBuilder<ELEM>::Optimize(std::move(result));
+}
+
 template <class ELEM>
 VtArrayEdit<ELEM>
 VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit const &weaker) &&
@@ -298,10 +666,10 @@ VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit const &weaker) &&
     // Both this and weaker consist of edits. We compose the edits and we can
     // steal our resources.
 
-    // For now we just append the stronger literals, and update all the stronger
-    // literal indexes with the offset.  We can do more in-depth analysis and
-    // things like dead store elimination and deduplicating literals in the
-    // future.
+    // Append the stronger literals and ops, updating all the stronger literal
+    // indexes with the offset, then let the builder deduplicate literals,
+    // eliminate dead stores and fold size ops.  Otherwise deep stacks of
+    // edits would grow with every layer.
 
     VtArrayEdit result = std::move(*this);
 
@@ -315,11 +683,19 @@ VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit const &weaker) &&
     // Bump the literal indexes in result._ops to account for weaker's
     // literals.
     const auto numWeakerLiterals = weaker._denseOrLiterals.size();
-    result._ops.ModifyEach([&](_Ops::Op op, int64_t &a1, int64_t) {
+    result._ops.ModifyEach([&](_Ops::Op op, int64_t &a1, int64_t &a2,
+                               int64_t) {
         switch (op) {
         case _Ops::OpWriteLiteral: // a1: literal index -> a2: result index.
         case _Ops::OpInsertLiteral:
+        case _Ops::OpWriteLiteralRange:
+        case _Ops::OpInsertLiteralRange:
             a1 += numWeakerLiterals;
+            break;
+        case _Ops::OpMinSizeFill: // a1: size, a2: literal index.
+        case _Ops::OpSetSizeFill:
+            a2 += numWeakerLiterals;
+            break;
         default:
             break;
         };
@@ -329,7 +705,7 @@ VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit const &weaker) &&
                             weaker._ops._ins.begin(),
                             weaker._ops._ins.end());
 
-    return result;
+    return VtArrayEditBuilder<ELEM>::Optimize(std::move(result));
 }
 
 template <class ELEM>
@@ -341,10 +717,10 @@ VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit &&weaker) &&
     // Both this and weaker consist of edits. We compose the edits and we can
     // steal both our resources and weaker's.
 
-    // For now we just append the stronger literals and stronger ops, and update
-    // all the stronger literal indexes with the offset.  We can do more
-    // in-depth analysis and things like dead store elimination and
-    // deduplicating literals in the future.
+    // Append the stronger literals and ops, updating all the stronger literal
+    // indexes with the offset, then let the builder deduplicate literals,
+    // eliminate dead stores and fold size ops.  Otherwise deep stacks of
+    // edits would grow with every layer.
 
     VtArrayEdit result = std::move(*this);
 
@@ -358,11 +734,19 @@ VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit &&weaker) &&
     
     // Bump the literal indexes in the stronger _ops to account for weaker's
     // literals.
-    result._ops.ModifyEach([&](_Ops::Op op, int64_t &a1, int64_t) {
+    result._ops.ModifyEach([&](_Ops::Op op, int64_t &a1, int64_t &a2,
+                               int64_t) {
         switch (op) {
         case _Ops::OpWriteLiteral: // a1: literal index -> a2: result index.
         case _Ops::OpInsertLiteral:
+        case _Ops::OpWriteLiteralRange:
+        case _Ops::OpInsertLiteralRange:
             a1 += numWeakerLiterals;
+            break;
+        case _Ops::OpMinSizeFill: // a1: size, a2: literal index.
+        case _Ops::OpSetSizeFill:
+            a2 += numWeakerLiterals;
+            break;
         default:
             break;
         };
@@ -374,7 +758,7 @@ VtArrayEdit<ELEM>::_ComposeEdits(VtArrayEdit &&weaker) &&
         std::make_move_iterator(result._ops._ins.begin()),
         std::make_move_iterator(result._ops._ins.end()));
 
-    return std::move(weaker);
+    return VtArrayEditBuilder<ELEM>::Optimize(std::move(weaker));
 }
 
 // Specialize traits for VtArrayEdit.
@@ -383,4 +767,7 @@ struct VtIsArrayEdit<VtArrayEdit<T>> : public std::true_type {};
 
 VT_NAMESPACE_CLOSE_SCOPE
 
+// Composition uses VtArrayEditBuilder::Optimize().
+#include "pxr/vt/arrayEditBuilder.h"
+
 #endif // PXR_VT_ARRAY_EDIT_H
@@ -9,6 +9,12 @@
 #include "pxr/vt/arrayEditBuilder.h"
 #include <pxr/tf/diagnostic.h>
 #include <pxr/tf/enum.h>
+#include <pxr/trace/trace.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include <vector>
 
 VT_NAMESPACE_OPEN_SCOPE
 
@@ -21,8 +27,28 @@ Vt_ArrayEditOpsBuilder::_CheckArity(Ops::Op op, int count) {
     return true;
 }
 
+void
+Vt_ArrayEditOpsBuilder::AddOp(Ops::Op op, int64_t a1, int64_t a2, int64_t a3) {
+    // Disallow negative counts for range ops.
+    if (a3 < 0) {
+        _IssueNegativeSizeError(op, a3);
+        return;
+    }
+    _AddOp(op);
+    if (_CheckArity(op, 3)) {
+        _ins.push_back(a1);
+        _ins.push_back(a2);
+        _ins.push_back(a3);
+    }
+}
+
 void
 Vt_ArrayEditOpsBuilder::AddOp(Ops::Op op, int64_t a1, int64_t a2) {
+    // Disallow negative counts for erase ranges.
+    if (a2 < 0 && op == Ops::OpEraseRange) {
+        _IssueNegativeSizeError(op, a2);
+        return;
+    }
     _AddOp(op);
     if (_CheckArity(op, 2)) {
         _ins.push_back(a1);
@@ -49,17 +75,337 @@ Vt_ArrayEditOpsBuilder::AddOp(Ops::Op op, int64_t a1) {
 }
 
 void
-Vt_ArrayEditOpsBuilder::_AddOp(Ops::Op op) {        
+Vt_ArrayEditOpsBuilder::AddOps(
+    Ops::Op op, TfSpan<const int64_t> a1s, TfSpan<const int64_t> a2s) {
+    if (a1s.empty() || !TF_VERIFY(a1s.size() == a2s.size()) ||
+        !_CheckArity(op, 2)) {
+        return;
+    }
+    if (op == Ops::OpEraseRange) {
+        // Erase ranges check their counts one at a time.
+        for (ptrdiff_t i = 0; i != a1s.size(); ++i) {
+            AddOp(op, a1s[i], a2s[i]);
+        }
+        return;
+    }
+    const size_t count = a1s.size();
+    _AddOp(op, count);
+    const size_t start = _ins.size();
+    _ins.resize(start + 2 * count);
+    for (size_t i = 0; i != count; ++i) {
+        _ins[start + 2 * i] = a1s[i];
+        _ins[start + 2 * i + 1] = a2s[i];
+    }
+}
+
+void
+Vt_ArrayEditOpsBuilder::AddOps(Ops::Op op, TfSpan<const int64_t> a1s) {
+    if (a1s.empty() || !_CheckArity(op, 1)) {
+        return;
+    }
+    if (op != Ops::OpEraseRef) {
+        // Size ops check their args one at a time.
+        for (int64_t a1: a1s) {
+            AddOp(op, a1);
+        }
+        return;
+    }
+    _AddOp(op, a1s.size());
+    _ins.insert(_ins.end(), a1s.begin(), a1s.end());
+}
+
+namespace {
+
+using _Ops = Vt_ArrayEditOps;
+
+struct _Ins {
+    _Ops::Op op;
+    int64_t a1;
+    int64_t a2;
+    int64_t a3;
+};
+
+// Size ops in the general form: clamp the size to [lo, hi], filling new
+// elements with literal <fill>, or value-initializing them if fill is -1.
+struct _SizeOp {
+    static constexpr int64_t NoLimit = std::numeric_limits<int64_t>::max();
+
+    // Return false if \p ins is not a size op with a valid size argument.
+    static bool FromIns(_Ins const &ins, _SizeOp *out) {
+        if (ins.a1 < 0) {
+            return false;
+        }
+        switch (ins.op) {
+        case _Ops::OpMinSize:     *out = { ins.a1, NoLimit, -1 };   break;
+        case _Ops::OpMinSizeFill: *out = { ins.a1, NoLimit, ins.a2 }; break;
+        case _Ops::OpSetSize:     *out = { ins.a1, ins.a1, -1 };    break;
+        case _Ops::OpSetSizeFill: *out = { ins.a1, ins.a1, ins.a2 }; break;
+        case _Ops::OpMaxSize:     *out = { 0, ins.a1, -1 };         break;
+        default:
+            return false;
+        };
+        return true;
+    }
+
+    // Compose \p next after this, returning false if the result cannot be
+    // expressed as a single _SizeOp.
+    bool Then(_SizeOp const &next) {
+        // Truncating then growing again refills elements that the composite
+        // would keep.
+        if (hi < next.lo) {
+            return false;
+        }
+        // The size after this op is at least lo, so next only grows if its lo
+        // is larger, and this only grows if lo is nonzero.
+        int64_t newFill = fill;
+        if (next.lo > lo) {
+            if (lo == 0) {
+                newFill = next.fill;
+            }
+            else if (fill != next.fill) {
+                return false;
+            }
+        }
+        const int64_t newLo = std::max(lo, next.lo);
+        const int64_t newHi = std::min(hi, next.hi);
+        if (newLo <= newHi) {
+            *this = { newLo, newHi, newFill };
+        }
+        else {
+            // lo > next.hi, so the result is always next.hi.
+            *this = { next.hi, next.hi, newFill };
+        }
+        return true;
+    }
+
+    void AppendTo(std::vector<_Ins> *out) const {
+        if (lo == hi) {
+            out->push_back(fill < 0 ?
+                           _Ins { _Ops::OpSetSize, lo, -1, -1 } :
+                           _Ins { _Ops::OpSetSizeFill, lo, fill, -1 });
+            return;
+        }
+        if (lo > 0) {
+            out->push_back(fill < 0 ?
+                           _Ins { _Ops::OpMinSize, lo, -1, -1 } :
+                           _Ins { _Ops::OpMinSizeFill, lo, fill, -1 });
+        }
+        if (hi != NoLimit) {
+            out->push_back({ _Ops::OpMaxSize, hi, -1, -1 });
+        }
+    }
+
+    int64_t lo;
+    int64_t hi;
+    int64_t fill;
+};
+
+// Remove writes that are overwritten before they can be read.  Only literal
+// writes overwrite, since a ref write is skipped if its source is out of
+// bounds.  Any other op, including range writes, ends the run of writes we
+// consider, since it may change the layout in a way that depends on the
+// array's size.
+void
+_EliminateDeadStores(std::vector<_Ins> *ins)
+{
+    // Indexes written later in the current run of writes, keeping
+    // non-negative and negative indexes apart since they may refer to the
+    // same element depending on the array's size.
+    std::unordered_set<int64_t> overwritten[2];
+
+    std::vector<bool> dead(ins->size());
+    for (size_t i = ins->size(); i--; ) {
+        _Ins const &cur = (*ins)[i];
+        if (cur.op != _Ops::OpWriteLiteral && cur.op != _Ops::OpWriteRef) {
+            overwritten[0].clear();
+            overwritten[1].clear();
+            continue;
+        }
+        const int64_t dst = cur.a2;
+        if (overwritten[dst < 0].count(dst)) {
+            dead[i] = true;
+            continue;
+        }
+        if (cur.op == _Ops::OpWriteLiteral) {
+            overwritten[dst < 0].insert(dst);
+        }
+        else {
+            // This reads a1, so earlier writes to it are live.
+            const int64_t src = cur.a1;
+            overwritten[src < 0].erase(src);
+            overwritten[src >= 0].clear();
+        }
+    }
+
+    size_t out = 0;
+    for (size_t i = 0; i != ins->size(); ++i) {
+        if (!dead[i]) {
+            (*ins)[out++] = (*ins)[i];
+        }
+    }
+    ins->resize(out);
+}
+
+// Fold runs of consecutive size ops.
+void
+_FoldSizeOps(std::vector<_Ins> *ins)
+{
+    std::vector<_Ins> result;
+    result.reserve(ins->size());
+
+    _SizeOp pending;
+    bool hasPending = false;
+    for (_Ins const &cur: *ins) {
+        _SizeOp sizeOp;
+        if (_SizeOp::FromIns(cur, &sizeOp)) {
+            if (!hasPending) {
+                pending = sizeOp;
+                hasPending = true;
+                continue;
+            }
+            if (pending.Then(sizeOp)) {
+                continue;
+            }
+            pending.AppendTo(&result);
+            pending = sizeOp;
+            continue;
+        }
+        if (hasPending) {
+            pending.AppendTo(&result);
+            hasPending = false;
+        }
+        result.push_back(cur);
+    }
+    if (hasPending) {
+        pending.AppendTo(&result);
+    }
+    ins->swap(result);
+}
+
+} // anon
+
+void
+Vt_ArrayEditOpsBuilder::Optimize()
+{
+    std::vector<_Ins> ins;
+    {
+        Ops ops;
+        ops._ins = std::move(_ins);
+        ops.ForEach([&ins](Ops::Op op, int64_t a1, int64_t a2, int64_t a3) {
+            ins.push_back({ op, a1, a2, a3 });
+        });
+    }
+
+    _EliminateDeadStores(&ins);
+    _FoldSizeOps(&ins);
+
+    _ins.clear();
+    _lastOpIdx = 0;
+    for (_Ins const &i: ins) {
+        switch (Ops::GetArity(i.op)) {
+        case 3:  AddOp(i.op, i.a1, i.a2, i.a3); break;
+        case 2:  AddOp(i.op, i.a1, i.a2);       break;
+        default: AddOp(i.op, i.a1);             break;
+        };
+    }
+}
+
+bool
+Vt_ArrayEditOpsBuilder::ComputeDiff(
+    size_t oldSize, size_t newSize, size_t maxChanges,
+    TfFunctionRef<bool (size_t, size_t)> equal,
+    std::vector<DiffHunk> *hunks)
+{
+    TRACE_FUNCTION();
+
+    hunks->clear();
+
+    // Myers' algorithm.  Walk diagonals k = x - y in an edit graph where x
+    // indexes the old array and y the new one.  Moving right erases an old
+    // element, moving down inserts a new one, and moving diagonally keeps an
+    // element common to both.  After d changes, v[k] is the furthest x
+    // reachable on diagonal k.  Keep each d's v to trace the path back.
+    const int64_t n = oldSize;
+    const int64_t m = newSize;
+    const int64_t maxD = std::min<uint64_t>(maxChanges, n + m);
+    const int64_t offset = maxD + 1;
+    std::vector<int64_t> v(2 * offset + 1, 0);
+    std::vector<std::vector<int64_t>> trace;
+
+    int64_t d = 0;
+    for (;; ++d) {
+        if (d > maxD) {
+            return false;
+        }
+        bool done = false;
+        for (int64_t k = -d; k <= d; k += 2) {
+            int64_t x = (k == -d || (k != d &&
+                                     v[offset + k - 1] < v[offset + k + 1]))
+                ? v[offset + k + 1] : v[offset + k - 1] + 1;
+            int64_t y = x - k;
+            while (x < n && y < m && equal(x, y)) {
+                ++x, ++y;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                done = true;
+                break;
+            }
+        }
+        trace.emplace_back(v.begin() + offset - d,
+                           v.begin() + offset + d + 1);
+        if (done) {
+            break;
+        }
+    }
+
+    // Trace the path back from (n, m), collecting hunks in reverse.  Each
+    // change extends the current hunk if no common elements separate them.
+    int64_t x = n, y = m;
+    for (; d > 0; --d) {
+        std::vector<int64_t> const &prev = trace[d - 1];
+        const int64_t k = x - y;
+        // prev holds diagonals [-(d - 1), d - 1].
+        auto prevX = [&prev, d](int64_t k) { return prev[k + d - 1]; };
+        const bool down = k == -d || (k != d && prevX(k - 1) < prevX(k + 1));
+        const int64_t prevK = down ? k + 1 : k - 1;
+        const int64_t px = prevX(prevK);
+        const int64_t py = px - prevK;
+
+        // The change goes from (px, py) to (cx, cy), then common elements
+        // follow up to (x, y).
+        const int64_t cx = down ? px : px + 1;
+        const int64_t cy = down ? py + 1 : py;
+        if (!hunks->empty() && cx == x && cy == y &&
+            hunks->back().oldIndex == x && hunks->back().newIndex == y) {
+            DiffHunk &hunk = hunks->back();
+            hunk.oldIndex = px;
+            hunk.newIndex = py;
+            hunk.oldCount += cx - px;
+            hunk.newCount += cy - py;
+        }
+        else {
+            hunks->push_back({ px, cx - px, py, cy - py });
+        }
+        x = px;
+        y = py;
+    }
+    std::reverse(hunks->begin(), hunks->end());
+    return true;
+}
+
+void
+Vt_ArrayEditOpsBuilder::_AddOp(Ops::Op op, int64_t count) {
     // If this is the first op, or this op differs from the prior, push a new
     // one.
     if (_ins.empty() || Ops::_ToOpAndCount(_ins[_lastOpIdx]).op != op) {
         _lastOpIdx = _ins.size();
-        _ins.push_back(Ops::_ToInt64({ 1, op }));
+        _ins.push_back(Ops::_ToInt64({ count, op }));
     }
     else {
         // Otherwise bump the count.
         Ops::OpAndCount oc = Ops::_ToOpAndCount(_ins[_lastOpIdx]);
-        ++oc.count;
+        oc.count += count;
         _ins[_lastOpIdx] = Ops::_ToInt64(oc);
     }
 }
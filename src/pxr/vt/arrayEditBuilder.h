@@ -19,9 +19,15 @@
 #include "pxr/vt/streamOut.h"
 
 #include <pxr/tf/diagnostic.h>
+#include <pxr/tf/functionRef.h>
 #include <pxr/tf/span.h>
 
-#include <unordered_map>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 VT_NAMESPACE_OPEN_SCOPE
 
@@ -31,17 +37,61 @@ class Vt_ArrayEditOpsBuilder
 public:
     using Ops = Vt_ArrayEditOps;
 
+    VT_API
+    void AddOp(Ops::Op op, int64_t a1, int64_t a2, int64_t a3);
+
     VT_API
     void AddOp(Ops::Op op, int64_t a1, int64_t a2);
 
     VT_API
     void AddOp(Ops::Op op, int64_t a1);
+
+    // Add an instruction for each element of \p a1s and \p a2s, which must
+    // have the same size, as if by calling AddOp() for each in turn.
+    VT_API
+    void AddOps(Ops::Op op,
+                TfSpan<const int64_t> a1s, TfSpan<const int64_t> a2s);
+
+    // Add an instruction for each element of \p a1s, as if by calling AddOp()
+    // for each in turn.
+    VT_API
+    void AddOps(Ops::Op op, TfSpan<const int64_t> a1s);
+
+    // Rewrite the ops added so far into an equivalent, shorter sequence.
+    // Drop writes that are overwritten by a later literal write to the same
+    // index before anything can read them, and fold each run of consecutive
+    // size ops into at most two.  This assumes equal literals have equal
+    // indexes.
+    VT_API
+    void Optimize();
+
+    // A range of \p oldCount elements at \p oldIndex in an old array that
+    // is replaced by the \p newCount elements at \p newIndex in a new array.
+    struct DiffHunk {
+        int64_t oldIndex;
+        int64_t oldCount;
+        int64_t newIndex;
+        int64_t newCount;
+    };
+
+    // Find a shortest sequence of erasures and insertions that turns an
+    // array of \p oldSize elements into one of \p newSize elements, where
+    // \p equal(i, j) returns true if old element i equals new element j, and
+    // store it in \p hunks in order.  This uses Myers' algorithm, which
+    // takes time proportional to the sizes times the number of changes, and
+    // space proportional to the square of the number of changes.  If more
+    // than \p maxChanges elements would be erased and inserted, give up and
+    // return false.
+    VT_API
+    static bool ComputeDiff(size_t oldSize, size_t newSize, size_t maxChanges,
+                            TfFunctionRef<bool (size_t, size_t)> equal,
+                            std::vector<DiffHunk> *hunks);
     
 private:
     template <class ELEM>
     friend class VtArrayEditBuilder;
 
-    void _AddOp(Ops::Op op);
+    void _AddOp(Ops::Op op, int64_t count = 1);
 
     static void _IssueArityError(Ops::Op op, int count);
     static void _IssueNegativeSizeError(Ops::Op op, int64_t size);
@@ -151,6 +201,102 @@ public:
         return *this;
     }
 
+    /// Add an instruction that writes the elements of \p elems to consecutive
+    /// indexes starting at \p index.  The \p index may be negative in which
+    /// case the array index is computed by adding to the array size to
+    /// produce a final index.  When applied, if any of the indexes are
+    /// out-of-bounds, this instruction is ignored.
+    Self &WriteRange(TfSpan<const ElementType> elems, int64_t index) {
+        if (!elems.empty()) {
+            _opsBuilder.AddOp(Ops::OpWriteLiteralRange,
+                              _AddLiterals(elems), index, elems.size());
+        }
+        return *this;
+    }
+
+    /// Add an instruction that writes the \p count elements starting at \p
+    /// srcIndex to the \p count elements starting at \p dstIndex.  The
+    /// ranges may overlap, in which case the elements are copied as if
+    /// through a temporary.  The indexes may be negative in which case the
+    /// array indexes are computed by adding to the array size to produce
+    /// final indexes.  When applied, if either range is out-of-bounds, this
+    /// instruction is ignored.
+    Self &WriteRefRange(int64_t srcIndex, int64_t dstIndex, int64_t count) {
+        _opsBuilder.AddOp(Ops::OpWriteRefRange, srcIndex, dstIndex, count);
+        return *this;
+    }
+
+    /// Add an instruction that inserts the elements of \p elems at \p index.
+    /// The \p index may be negative in which case the array index is computed
+    /// by adding to the array size to produce a final index.  The index may
+    /// also be \p EndIndex, which indicates insertion at the end.  When
+    /// applied, if \p index is out-of-bounds and not EndIndex, this
+    /// instruction is ignored.
+    Self &InsertRange(TfSpan<const ElementType> elems, int64_t index) {
+        if (!elems.empty()) {
+            _opsBuilder.AddOp(Ops::OpInsertLiteralRange,
+                              _AddLiterals(elems), index, elems.size());
+        }
+        return *this;
+    }
+
+    /// Add an instruction that inserts copies of the \p count elements
+    /// starting at \p srcIndex at \p dstIndex.  The indexes may be negative
+    /// in which case the array indexes are computed by adding to the array
+    /// size to produce the final indexes.  The dstIndex may also be \p
+    /// EndIndex, which indicates insertion at the end.  When applied, if the
+    /// source range is out-of-bounds or dstIndex is out of bounds and not
+    /// EndIndex, this instruction is ignored.
+    Self &InsertRefRange(int64_t srcIndex, int64_t dstIndex, int64_t count) {
+        _opsBuilder.AddOp(Ops::OpInsertRefRange, srcIndex, dstIndex, count);
+        return *this;
+    }
+
+    /// Add an instruction that erases the \p count elements starting at \p
+    /// index.  The \p index may be negative in which case the array index is
+    /// computed by adding to the array size to produce a final index.  When
+    /// applied, if any of the elements are out-of-bounds, this instruction is
+    /// ignored.
+    Self &EraseRange(int64_t index, int64_t count) {
+        _opsBuilder.AddOp(Ops::OpEraseRange, index, count);
+        return *this;
+    }
+
+    /// Add instructions that write each element of \p elems to the
+    /// corresponding index in \p indexes, as if by calling Write() for each
+    /// in turn, but faster.  If \p elems and \p indexes differ in size, issue
+    /// a coding error and add nothing.
+    Self &WriteMany(TfSpan<const ElementType> elems,
+                    TfSpan<const int64_t> indexes) {
+        if (_CheckManySizes(elems.size(), indexes.size())) {
+            const std::vector<int64_t> literals = _FindOrAddLiterals(elems);
+            _opsBuilder.AddOps(Ops::OpWriteLiteral, literals, indexes);
+        }
+        return *this;
+    }
+
+    /// Add instructions that insert each element of \p elems at the
+    /// corresponding index in \p indexes, as if by calling Insert() for each
+    /// in turn, but faster.  Each insertion applies to the result of the
+    /// previous ones.  If \p elems and \p indexes differ in size, issue a
+    /// coding error and add nothing.
+    Self &InsertMany(TfSpan<const ElementType> elems,
+                     TfSpan<const int64_t> indexes) {
+        if (_CheckManySizes(elems.size(), indexes.size())) {
+            const std::vector<int64_t> literals = _FindOrAddLiterals(elems);
+            _opsBuilder.AddOps(Ops::OpInsertLiteral, literals, indexes);
+        }
+        return *this;
+    }
+
+    /// Add instructions that erase the element at each of \p indexes, as if
+    /// by calling EraseRef() for each in turn, but faster.  Each erasure
+    /// applies to the result of the previous ones.
+    Self &EraseMany(TfSpan<const int64_t> indexes) {
+        _opsBuilder.AddOps(Ops::OpEraseRef, indexes);
+        return *this;
+    }
+
     /// Add an instruction that, if the array's size is less than \p size,
     /// appends value-initialized elements to the array until it has \p size.
     Self &MinSize(int64_t size) {
@@ -201,11 +347,36 @@ public:
         return result;
     }
 
+    /// Return a VtArrayEdit that performs the edits specified to each of \p
+    /// builders in turn, as if they had all been made to one builder, then
+    /// reset each of \p builders as FinalizeAndReset() does.  Literals that
+    /// are equal across builders are stored once, except those added by
+    /// WriteRange() and InsertRange(), which stay contiguous.
+    ///
+    /// This lets several threads build one edit concurrently, each with its
+    /// own builder.  The result depends only on the order of \p builders, so
+    /// to make it deterministic, give each task the builder for its part of
+    /// the work, such as its chunk index, rather than one per thread.  The
+    /// literals and instructions are copied into the result in parallel.
+    static VtArrayEdit<ELEM> MergeAndReset(TfSpan<VtArrayEditBuilder> builders);
+
     /// Given a VtArrayEdit that may have been composed from several, attempt to
     /// produce a smaller, optimized edit that acts identically.  If \p in
     /// represents a dense array or is the identity, return it unmodified.
     static VtArrayEdit<ELEM> Optimize(VtArrayEdit<ELEM> &&in);
 
+    /// Return an edit that, composed over \p oldArray, produces \p newArray.
+    /// If the arrays have the same size, the edit writes each run of
+    /// differing elements.  Otherwise it erases and inserts a minimal number
+    /// of elements, overwriting rather than erasing and inserting where it
+    /// can.  If that needs more than \p maxChanges erasures and insertions,
+    /// or the edit would need as many literal elements as \p newArray has,
+    /// return \p newArray as a dense edit instead.  If the arrays are equal,
+    /// return the identity.
+    static VtArrayEdit<ELEM> Diff(Array const &oldArray,
+                                  Array const &newArray,
+                                  size_t maxChanges = 1024);
+
     // Return data for serializing `edit`, so it can be reconstructed later by
     // CreateFromSerializationData().  Note that VtArrayEdit::IsDense() is also
     // required, but can be obtained by calling that public API.
@@ -237,19 +408,170 @@ public:
         result._isDense = isDense;
         return result;
     }
+
+    // Return data for serializing `edit` compactly, as with
+    // GetSerializationData(), but with the instructions encoded into bytes
+    // that typically take a fraction of the space.  The edit can be
+    // reconstructed by CreateFromCompactSerializationData().
+    //
+    // This API is intended to be called only by storage/transmission
+    // implementations.
+    static void
+    GetCompactSerializationData(VtArrayEdit<ELEM> const &edit,
+                                VtArray<ELEM> *valuesOut,
+                                std::vector<uint8_t> *bytesOut) {
+        if (TF_VERIFY(valuesOut) && TF_VERIFY(bytesOut)) {
+            *valuesOut = edit._denseOrLiterals;
+            bytesOut->clear();
+            edit._ops.EncodeCompact(bytesOut);
+        }
+    }
+
+    // Construct an array edit using serialization data previously obtained from
+    // GetCompactSerializationData() and VtArrayEdit::IsDense().  The
+    // instructions are decoded directly into the result.  If \p bytes is
+    // malformed, issue a runtime error and return the identity edit.
+    //
+    // This API is intended to be called only by storage/transmission
+    // implementations.
+    static VtArrayEdit<ELEM>
+    CreateFromCompactSerializationData(VtArray<ELEM> const &values,
+                                       TfSpan<const uint8_t> bytes,
+                                       bool isDense) {
+        VtArrayEdit<ELEM> result;
+        if (!result._ops.DecodeCompact(bytes)) {
+            return result;
+        }
+        result._denseOrLiterals = values;
+        result._isDense = isDense;
+        return result;
+    }
     
 private:
+    // Literals are deduplicated with an open-addressing hash table whose
+    // slots hold the hash and index of a literal in _literals, so adding one
+    // costs no allocation beyond the occasional doubling of the table.
+    struct _LiteralSlot {
+        size_t hash;
+        int64_t index; // -1 if empty.
+    };
+
+    // Return the slot in \p slots, which has 2^(64 - shift) entries, for an
+    // element with \p hash: either the one whose index isEqual() accepts, or
+    // the empty one where it belongs.
+    template <class IsEqual>
+    static _LiteralSlot &_FindSlot(std::vector<_LiteralSlot> &slots,
+                                   int shift, size_t hash,
+                                   IsEqual const &isEqual) {
+        // Fibonacci hashing spreads the hash's bits over the table index.
+        const size_t mask = slots.size() - 1;
+        size_t i = (hash * 0x9E3779B97F4A7C15ull) >> shift;
+        for (;; i = (i + 1) & mask) {
+            _LiteralSlot &slot = slots[i];
+            if (slot.index < 0 ||
+                (slot.hash == hash && isEqual(slot.index))) {
+                return slot;
+            }
+        }
+    }
+
+    // Return the shift for a table of \p numSlots entries, a power of two.
+    static int _GetSlotShift(size_t numSlots) {
+        int shift = 64;
+        for (size_t n = numSlots; n > 1; n >>= 1) {
+            --shift;
+        }
+        return shift;
+    }
+
+    // Return the slot for \p elem with \p hash: either the one that holds an
+    // equal literal, or the empty one where it belongs.
+    _LiteralSlot &_FindLiteralSlot(ElementType const &elem, size_t hash) {
+        return _FindSlot(_literalSlots, _literalSlotShift, hash,
+                         [this, &elem](int64_t index) {
+                             return _literals.cdata()[index] == elem;
+                         });
+    }
+
+    // Make room for one more entry in the literal table, keeping it at most
+    // half full.
+    void _ReserveLiteralSlot() {
+        if (2 * (_numLiteralSlotsUsed + 1) <= _literalSlots.size()) {
+            return;
+        }
+        std::vector<_LiteralSlot> oldSlots(
+            std::max<size_t>(16, 2 * _literalSlots.size()), { 0, -1 });
+        oldSlots.swap(_literalSlots);
+        _literalSlotShift = _GetSlotShift(_literalSlots.size());
+        for (_LiteralSlot const &slot: oldSlots) {
+            if (slot.index >= 0) {
+                _FindLiteralSlot(_literals.cdata()[slot.index], slot.hash) =
+                    slot;
+            }
+        }
+    }
+
     int64_t _FindOrAddLiteral(ElementType const &elem) {
-        auto iresult = _literalToIndex.emplace(elem, _literals.size());
-        if (iresult.second) {
+        _ReserveLiteralSlot();
+        const size_t hash = TfHash{}(elem);
+        _LiteralSlot &slot = _FindLiteralSlot(elem, hash);
+        if (slot.index < 0) {
+            slot = { hash, static_cast<int64_t>(_literals.size()) };
+            ++_numLiteralSlotsUsed;
             _literals.push_back(elem);
         }
-        return iresult.first->second;
+        return slot.index;
+    }
+
+    // Add literal \p index to the literal table if no equal literal is there.
+    void _IndexLiteral(int64_t index) {
+        _ReserveLiteralSlot();
+        ElementType const &elem = _literals.cdata()[index];
+        const size_t hash = TfHash{}(elem);
+        _LiteralSlot &slot = _FindLiteralSlot(elem, hash);
+        if (slot.index < 0) {
+            slot = { hash, index };
+            ++_numLiteralSlotsUsed;
+        }
+    }
+
+    // Append \p elems to the literals without deduplicating them, so they
+    // stay contiguous, and return the index of the first.
+    int64_t _AddLiterals(TfSpan<const ElementType> elems) {
+        const size_t start = _literals.size();
+        _literals.resize(start + elems.size(),
+                         [&elems](ElementType *first, ElementType *) {
+                             std::uninitialized_copy(
+                                 elems.begin(), elems.end(), first);
+                         });
+        return start;
+    }
+
+    // Return the literal indexes of \p elems, adding any that are new.
+    std::vector<int64_t> _FindOrAddLiterals(TfSpan<const ElementType> elems) {
+        std::vector<int64_t> indexes(elems.size());
+        for (size_t i = 0; i != indexes.size(); ++i) {
+            indexes[i] = _FindOrAddLiteral(elems[i]);
+        }
+        return indexes;
+    }
+
+    static bool _CheckManySizes(size_t numElems, size_t numIndexes) {
+        if (numElems != numIndexes) {
+            TF_CODING_ERROR("Mismatched number of elements (%zu) and "
+                            "indexes (%zu)", numElems, numIndexes);
+            return false;
+        }
+        return true;
     }
+
+    void _RemoveUnusedLiterals();
     
     Array _literals;
     Vt_ArrayEditOpsBuilder _opsBuilder;
-    std::unordered_map<ElementType, int64_t, TfHash> _literalToIndex;
+    std::vector<_LiteralSlot> _literalSlots;
+    size_t _numLiteralSlotsUsed = 0;
+    int _literalSlotShift = 64;
    
 };
 
@@ -272,7 +594,14 @@ VtArrayEditBuilder<ELEM>::Optimize(VtArrayEdit<ELEM> &&in)
     in._denseOrLiterals.clear();
     in._ops = {};
     
-    ops.ForEach([&](Ops::Op op, int64_t a1, int64_t a2) {
+    // Return true if the \p count literals at \p index are in range.
+    auto validLiterals = [numLiterals](int64_t index, int64_t count) {
+        return index >= 0 && count >= 0 &&
+            static_cast<size_t>(index) <= numLiterals &&
+            static_cast<size_t>(count) <= numLiterals - index;
+    };
+    
+    ops.ForEach([&](Ops::Op op, int64_t a1, int64_t a2, int64_t a3) {
         switch (op) {
         case Ops::OpWriteLiteral:
             // Ignore out-of-range literal indexes.
@@ -294,22 +623,392 @@ VtArrayEditBuilder<ELEM>::Optimize(VtArrayEdit<ELEM> &&in)
         case Ops::OpMaxSize:   builder.MaxSize(a1);       break;
         case Ops::OpMinSizeFill:
             // Ignore out-of-range literal indexes.
-            if (a1 >= 0 && static_cast<size_t>(a1) < numLiterals) {
+            if (a2 >= 0 && static_cast<size_t>(a2) < numLiterals) {
                 builder.MinSize(a1, literals[a2]);
             }
             break;
         case Ops::OpSetSizeFill:
             // Ignore out-of-range literal indexes.
-            if (a1 >= 0 && static_cast<size_t>(a1) < numLiterals) {
+            if (a2 >= 0 && static_cast<size_t>(a2) < numLiterals) {
                 builder.SetSize(a1, literals[a2]);
             }
             break;
+        case Ops::OpWriteLiteralRange:
+            // Ignore out-of-range literal indexes.
+            if (validLiterals(a1, a3)) {
+                builder.WriteRange(
+                    TfSpan<const ElementType>(literals.cdata() + a1, a3), a2);
+            }
+            break;
+        case Ops::OpInsertLiteralRange:
+            // Ignore out-of-range literal indexes.
+            if (validLiterals(a1, a3)) {
+                builder.InsertRange(
+                    TfSpan<const ElementType>(literals.cdata() + a1, a3), a2);
+            }
+            break;
+        case Ops::OpWriteRefRange:  builder.WriteRefRange(a1, a2, a3);  break;
+        case Ops::OpInsertRefRange: builder.InsertRefRange(a1, a2, a3); break;
+        case Ops::OpEraseRange:     builder.EraseRange(a1, a2);         break;
         };
     });
+
+    // The builder has deduplicated the literals, so now eliminate dead stores
+    // and fold size ops, then drop any literals only they used.
+    builder._opsBuilder.Optimize();
+    builder._RemoveUnusedLiterals();
     
     return builder.FinalizeAndReset();
 }
 
+template <class ELEM>
+VtArrayEdit<ELEM>
+VtArrayEditBuilder<ELEM>::Diff(Array const &oldArray,
+                               Array const &newArray,
+                               size_t maxChanges)
+{
+    TRACE_FUNCTION();
+
+    if (oldArray.IsIdentical(newArray)) {
+        return {};
+    }
+
+    ElementType const *oldData = oldArray.cdata();
+    ElementType const *newData = newArray.cdata();
+    const size_t oldSize = oldArray.size();
+    const size_t newSize = newArray.size();
+
+    // Skip the common prefix and suffix.
+    const size_t minSize = std::min(oldSize, newSize);
+    const size_t prefix = std::mismatch(
+        oldData, oldData + minSize, newData).first - oldData;
+    size_t suffix = 0;
+    while (suffix != minSize - prefix &&
+           oldData[oldSize - suffix - 1] == newData[newSize - suffix - 1]) {
+        ++suffix;
+    }
+    if (prefix == minSize && oldSize == newSize) {
+        return {};
+    }
+
+    VtArrayEditBuilder builder;
+    auto write = [&builder, newData](int64_t index, int64_t count) {
+        if (count == 1) {
+            builder.Write(newData[index], index);
+        }
+        else if (count > 1) {
+            builder.WriteRange(
+                TfSpan<const ElementType>(newData + index, count), index);
+        }
+    };
+
+    if (oldSize == newSize) {
+        // Write each run of differing elements.
+        for (size_t i = prefix, end = oldSize - suffix; i != end; ) {
+            if (oldData[i] == newData[i]) {
+                ++i;
+                continue;
+            }
+            size_t j = i + 1;
+            while (j != end && !(oldData[j] == newData[j])) {
+                ++j;
+            }
+            write(i, j - i);
+            i = j;
+        }
+    }
+    else {
+        std::vector<Vt_ArrayEditOpsBuilder::DiffHunk> hunks;
+        if (!Vt_ArrayEditOpsBuilder::ComputeDiff(
+                oldSize - prefix - suffix, newSize - prefix - suffix,
+                maxChanges, [oldData, newData, prefix](size_t i, size_t j) {
+                    return oldData[prefix + i] == newData[prefix + j];
+                }, &hunks)) {
+            return Edit(newArray);
+        }
+
+        // Each hunk applies after those before it, which have already given
+        // the preceding elements their new positions.
+        for (Vt_ArrayEditOpsBuilder::DiffHunk const &hunk: hunks) {
+            const int64_t index = prefix + hunk.newIndex;
+            const int64_t common = std::min(hunk.oldCount, hunk.newCount);
+            write(index, common);
+            if (hunk.newCount > common) {
+                const int64_t count = hunk.newCount - common;
+                if (count == 1) {
+                    builder.Insert(newData[index + common], index + common);
+                }
+                else {
+                    builder.InsertRange(TfSpan<const ElementType>(
+                                            newData + index + common, count),
+                                        index + common);
+                }
+            }
+            else if (hunk.oldCount > common) {
+                const int64_t count = hunk.oldCount - common;
+                if (count == 1) {
+                    builder.EraseRef(index + common);
+                }
+                else {
+                    builder.EraseRange(index + common, count);
+                }
+            }
+        }
+    }
+
+    // An edit that carries as many elements as the new array saves nothing.
+    if (builder._literals.size() >= newSize) {
+        return Edit(newArray);
+    }
+    return builder.FinalizeAndReset();
+}
+
+template <class ELEM>
+VtArrayEdit<ELEM>
+VtArrayEditBuilder<ELEM>::MergeAndReset(TfSpan<VtArrayEditBuilder> builders)
+{
+    TRACE_FUNCTION();
+
+    // Literals are identified by their position in the concatenation of the
+    // builders' literals.  Each is shared with an equal literal from an
+    // earlier builder where possible.  The literals are split by hash into
+    // shards that are deduplicated in parallel, which also keeps each
+    // shard's table small enough to stay in cache.
+    constexpr int shardBits = 6;
+    constexpr size_t numShards = size_t(1) << shardBits;
+
+    const size_t numBuilders = builders.size();
+    std::vector<Ops> ops(numBuilders);
+    std::vector<size_t> literalStarts(numBuilders + 1, 0);
+    std::vector<size_t> insStarts(numBuilders + 1, 0);
+    for (size_t b = 0; b != numBuilders; ++b) {
+        ops[b]._ins = std::move(builders[b]._opsBuilder._ins);
+        literalStarts[b + 1] =
+            literalStarts[b] + builders[b]._literals.size();
+        insStarts[b + 1] = insStarts[b] + ops[b]._ins.size();
+    }
+    const size_t numLiterals = literalStarts.back();
+
+    auto forEachBuilder = [numBuilders](auto const &fn) {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, numBuilders),
+            [&fn](tbb::blocked_range<size_t> const &r) {
+                for (size_t b = r.begin(); b != r.end(); ++b) {
+                    fn(b);
+                }
+            });
+    };
+
+    // Hash each builder's literals and group them by shard.  Literals that
+    // the builder uses in ranges must stay contiguous, so they are never
+    // shared.
+    std::vector<ElementType const *> sources(numLiterals);
+    std::vector<int64_t> canonical(numLiterals);
+    std::vector<std::vector<_LiteralSlot>> shardSlots(numBuilders);
+    std::vector<std::vector<size_t>> shardStarts(numBuilders);
+    forEachBuilder([&](size_t b) {
+        VtArrayEditBuilder const &builder = builders[b];
+        const size_t start = literalStarts[b];
+        std::vector<bool> inRange(builder._literals.size());
+        for (size_t i = 0; i != inRange.size(); ++i) {
+            sources[start + i] = builder._literals.cdata() + i;
+            canonical[start + i] = start + i;
+        }
+        ops[b].ForEach(
+            [&inRange](Ops::Op op, int64_t a1, int64_t, int64_t a3) {
+                if (op == Ops::OpWriteLiteralRange ||
+                    op == Ops::OpInsertLiteralRange) {
+                    std::fill_n(inRange.begin() + a1, a3, true);
+                }
+            });
+        std::vector<size_t> hashes(inRange.size());
+        std::vector<size_t> &starts = shardStarts[b];
+        starts.assign(numShards + 1, 0);
+        for (size_t i = 0; i != hashes.size(); ++i) {
+            if (!inRange[i]) {
+                hashes[i] = TfHash{}(*sources[start + i]);
+                ++starts[(hashes[i] >> (64 - shardBits)) + 1];
+            }
+        }
+        for (size_t shard = 0; shard != numShards; ++shard) {
+            starts[shard + 1] += starts[shard];
+        }
+        std::vector<size_t> ends(starts.begin(), starts.end() - 1);
+        shardSlots[b].resize(starts.back());
+        for (size_t i = 0; i != hashes.size(); ++i) {
+            if (!inRange[i]) {
+                shardSlots[b][ends[hashes[i] >> (64 - shardBits)]++] =
+                    { hashes[i], static_cast<int64_t>(start + i) };
+            }
+        }
+    });
+
+    // Point each literal at the first equal one, visiting builders in order.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, numShards),
+        [&](tbb::blocked_range<size_t> const &r) {
+            for (size_t shard = r.begin(); shard != r.end(); ++shard) {
+                size_t numSlots = 16, numUsed = 0;
+                for (size_t b = 0; b != numBuilders; ++b) {
+                    numUsed += shardStarts[b][shard + 1] -
+                        shardStarts[b][shard];
+                }
+                while (numSlots < 2 * numUsed) {
+                    numSlots *= 2;
+                }
+                std::vector<_LiteralSlot> table(numSlots, { 0, -1 });
+                const int shift = _GetSlotShift(numSlots);
+                for (size_t b = 0; b != numBuilders; ++b) {
+                    for (size_t i = shardStarts[b][shard],
+                             end = shardStarts[b][shard + 1]; i != end; ++i) {
+                        _LiteralSlot const &slot = shardSlots[b][i];
+                        ElementType const &elem = *sources[slot.index];
+                        _LiteralSlot &found = _FindSlot(
+                            table, shift, slot.hash,
+                            [&sources, &elem](int64_t index) {
+                                return *sources[index] == elem;
+                            });
+                        if (found.index < 0) {
+                            found = slot;
+                        }
+                        else {
+                            canonical[slot.index] = found.index;
+                        }
+                    }
+                }
+            }
+        });
+
+    // Number the literals that remain in order, then give the others the
+    // numbers of those they are equal to.
+    std::vector<size_t> newStarts(numBuilders + 1, 0);
+    forEachBuilder([&](size_t b) {
+        size_t count = 0;
+        for (size_t g = literalStarts[b]; g != literalStarts[b + 1]; ++g) {
+            count += canonical[g] == static_cast<int64_t>(g);
+        }
+        newStarts[b + 1] = count;
+    });
+    for (size_t b = 0; b != numBuilders; ++b) {
+        newStarts[b + 1] += newStarts[b];
+    }
+    std::vector<int64_t> newIndexes(numLiterals);
+    forEachBuilder([&](size_t b) {
+        int64_t next = newStarts[b];
+        for (size_t g = literalStarts[b]; g != literalStarts[b + 1]; ++g) {
+            if (canonical[g] == static_cast<int64_t>(g)) {
+                newIndexes[g] = next++;
+            }
+        }
+    });
+    forEachBuilder([&](size_t b) {
+        for (size_t g = literalStarts[b]; g != literalStarts[b + 1]; ++g) {
+            if (canonical[g] != static_cast<int64_t>(g)) {
+                newIndexes[g] = newIndexes[canonical[g]];
+            }
+        }
+    });
+
+    // Copy the remaining literals and renumber and copy the instructions.
+    VtArrayEdit<ELEM> result;
+    result._denseOrLiterals.resize(
+        newStarts.back(), [&](ElementType *out, ElementType *) {
+            forEachBuilder([&](size_t b) {
+                for (size_t g = literalStarts[b];
+                     g != literalStarts[b + 1]; ++g) {
+                    if (canonical[g] == static_cast<int64_t>(g)) {
+                        ::new (static_cast<void *>(out + newIndexes[g]))
+                            ElementType(*sources[g]);
+                    }
+                }
+            });
+        });
+    std::vector<int64_t> &ins = result._ops._ins;
+    ins.resize(insStarts.back());
+    forEachBuilder([&](size_t b) {
+        int64_t const *indexes = newIndexes.data() + literalStarts[b];
+        ops[b].ModifyEach(
+            [indexes](Ops::Op op, int64_t &a1, int64_t &a2, int64_t &) {
+                switch (op) {
+                case Ops::OpWriteLiteral:
+                case Ops::OpInsertLiteral:
+                case Ops::OpWriteLiteralRange:
+                case Ops::OpInsertLiteralRange:
+                    a1 = indexes[a1];
+                    break;
+                case Ops::OpMinSizeFill:
+                case Ops::OpSetSizeFill:
+                    a2 = indexes[a2];
+                    break;
+                default:
+                    break;
+                };
+            });
+        std::copy(ops[b]._ins.begin(), ops[b]._ins.end(),
+                  ins.begin() + insStarts[b]);
+    });
+
+    for (VtArrayEditBuilder &builder: builders) {
+        builder = {};
+    }
+    return result;
+}
+
+template <class ELEM>
+void
+VtArrayEditBuilder<ELEM>::_RemoveUnusedLiterals()
+{
+    Ops ops;
+    ops._ins = std::move(_opsBuilder._ins);
+
+    // Renumber literals in order of first use.  Ranges of literals are
+    // always copied, since they must stay contiguous.
+    std::vector<int64_t> newIndexes(_literals.size(), -1);
+    Array used;
+    auto renumber = [&](int64_t &index) {
+        if (newIndexes[index] < 0) {
+            newIndexes[index] = used.size();
+            used.push_back(_literals[index]);
+        }
+        index = newIndexes[index];
+    };
+    auto renumberRange = [&](int64_t &index, int64_t count) {
+        const int64_t newIndex = used.size();
+        for (int64_t i = index; i != index + count; ++i) {
+            used.push_back(_literals[i]);
+        }
+        index = newIndex;
+    };
+    ops.ModifyEach([&](Ops::Op op, int64_t &a1, int64_t &a2, int64_t &a3) {
+        switch (op) {
+        case Ops::OpWriteLiteral:
+        case Ops::OpInsertLiteral:
+            renumber(a1);
+            break;
+        case Ops::OpMinSizeFill:
+        case Ops::OpSetSizeFill:
+            renumber(a2);
+            break;
+        case Ops::OpWriteLiteralRange:
+        case Ops::OpInsertLiteralRange:
+            renumberRange(a1, a3);
+            break;
+        default:
+            break;
+        };
+    });
+    _opsBuilder._ins = std::move(ops._ins);
+
+    _literals = std::move(used);
+    _literalSlots.clear();
+    _numLiteralSlotsUsed = 0;
+    for (size_t i = 0; i != newIndexes.size(); ++i) {
+        if (newIndexes[i] >= 0) {
+            _IndexLiteral(newIndexes[i]);
+        }
+    }
+}
+
 VT_NAMESPACE_CLOSE_SCOPE
 
 #endif // PXR_VT_ARRAY_EDIT_BUILDER_H
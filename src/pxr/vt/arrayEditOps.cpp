@@ -12,6 +12,9 @@
 #include <pxr/tf/enum.h>
 #include <pxr/tf/registryManager.h>
 
+#include <algorithm>
+#include <vector>
+
 VT_NAMESPACE_OPEN_SCOPE
 
 TF_REGISTRY_FUNCTION(TfEnum)
@@ -26,6 +29,711 @@ TF_REGISTRY_FUNCTION(TfEnum)
     TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpSetSize);
     TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpSetSizeFill);
     TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpMaxSize);
+    TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpWriteLiteralRange);
+    TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpWriteRefRange);
+    TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpInsertLiteralRange);
+    TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpInsertRefRange);
+    TF_ADD_ENUM_NAME(Vt_ArrayEditOps::OpEraseRange);
+}
+
+namespace {
+
+using _Run = Vt_ArrayEditOps::Run;
+using _Runs = std::vector<_Run>;
+
+// Return true if \p b directly continues \p a, so they can be merged.
+bool
+_Continues(_Run const &a, _Run const &b)
+{
+    if (a.kind != b.kind) {
+        return false;
+    }
+    switch (a.kind) {
+    case _Run::Source:
+    case _Run::Literals: return a.index + a.count == b.index;
+    case _Run::Literal:  return a.index == b.index;
+    case _Run::Default:  return true;
+    };
+    return false;
+}
+
+// Return the part of \p run that starts \p offset elements in and has \p
+// count elements.
+_Run
+_SubRun(_Run run, int64_t offset, int64_t count)
+{
+    if (run.kind == _Run::Source || run.kind == _Run::Literals) {
+        run.index += offset;
+    }
+    run.count = count;
+    return run;
+}
+
+// The layout of an array being edited, as a sequence of runs.  The runs are
+// kept in a treap ordered by position, where each node also counts the
+// elements in its subtree, so finding, splitting and replacing the runs at
+// any position takes expected time logarithmic in the number of runs.
+class _Layout
+{
+public:
+    explicit _Layout(size_t size) {
+        // Node 0 is the empty tree.
+        _nodes.emplace_back();
+        if (size) {
+            _root = _NewNode(
+                { 0, static_cast<int64_t>(size), _Run::Source }, _Random());
+        }
+    }
+
+    size_t GetSize() const {
+        return _nodes[_root].size;
+    }
+
+    // Return the runs for the \p count elements starting at \p pos.
+    _Runs Get(size_t pos, size_t count) const {
+        _Runs result;
+        if (count) {
+            _Collect(_root, 0, pos, pos + count, &result);
+        }
+        return result;
+    }
+
+    // Replace the \p count elements starting at \p pos with \p runs.
+    void Replace(size_t pos, size_t count, _Runs const &runs) {
+        _Index before, replaced, after;
+        _Split(_root, pos, &before, &after);
+        _Split(after, count, &replaced, &after);
+        _Free(replaced);
+
+        // Take the runs on either side, so that they can merge with the new
+        // ones.
+        _Runs merged;
+        merged.reserve(runs.size() + 2);
+        const auto append = [&merged](_Run const &run) {
+            if (run.count == 0) {
+                return;
+            }
+            if (!merged.empty() && _Continues(merged.back(), run)) {
+                merged.back().count += run.count;
+            }
+            else {
+                merged.push_back(run);
+            }
+        };
+        if (before) {
+            append(_PopBack(&before));
+        }
+        for (_Run const &run: runs) {
+            append(run);
+        }
+        if (after) {
+            append(_PopFront(&after));
+        }
+
+        for (_Run const &run: merged) {
+            before = _Merge(before, _NewNode(run, _Random()));
+        }
+        _root = _Merge(before, after);
+    }
+
+    void Insert(size_t pos, _Runs const &runs) {
+        Replace(pos, 0, runs);
+    }
+
+    void Write(size_t pos, _Runs const &runs) {
+        size_t count = 0;
+        for (_Run const &run: runs) {
+            count += run.count;
+        }
+        Replace(pos, count, runs);
+    }
+
+    void Erase(size_t pos, size_t count) {
+        Replace(pos, count, {});
+    }
+
+    // Resize to \p size, filling new elements as in \p fill.
+    void Resize(size_t size, _Run fill) {
+        const size_t oldSize = GetSize();
+        if (size < oldSize) {
+            Erase(size, oldSize - size);
+        }
+        else if (size > oldSize) {
+            fill.count = size - oldSize;
+            Insert(oldSize, { fill });
+        }
+    }
+
+    _Runs Release() {
+        _Runs result;
+        _Append(_root, &result);
+        _nodes.clear();
+        _free.clear();
+        _root = 0;
+        return result;
+    }
+
+private:
+    using _Index = size_t;
+
+    struct _Node {
+        _Run run { 0, 0, _Run::Source };
+        // The number of elements in this subtree.
+        size_t size = 0;
+        _Index left = 0;
+        _Index right = 0;
+        uint32_t priority = 0;
+    };
+
+    // A xorshift generator: the priorities only need to be well spread,
+    // and being deterministic keeps the work repeatable.
+    uint32_t _Random() {
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 17;
+        _seed ^= _seed << 5;
+        return _seed;
+    }
+
+    _Index _NewNode(_Run const &run, uint32_t priority) {
+        _Index i;
+        if (_free.empty()) {
+            i = _nodes.size();
+            _nodes.emplace_back();
+        }
+        else {
+            i = _free.back();
+            _free.pop_back();
+        }
+        _Node &node = _nodes[i];
+        node.run = run;
+        node.size = run.count;
+        node.left = node.right = 0;
+        node.priority = priority;
+        return i;
+    }
+
+    // Return the nodes of the tree at \p t for reuse.
+    void _Free(_Index t) {
+        if (t) {
+            _Free(_nodes[t].left);
+            _Free(_nodes[t].right);
+            _free.push_back(t);
+        }
+    }
+
+    void _Update(_Index t) {
+        _Node &node = _nodes[t];
+        node.size = _nodes[node.left].size + node.run.count +
+            _nodes[node.right].size;
+    }
+
+    // Split the tree at \p t into its first \p pos elements in \p left and
+    // the rest in \p right, splitting the run that straddles \p pos.
+    void _Split(_Index t, size_t pos, _Index *left, _Index *right) {
+        if (!t) {
+            *left = *right = 0;
+            return;
+        }
+        // _NewNode may reallocate _nodes, so refer to nodes by index.
+        const size_t leftSize = _nodes[_nodes[t].left].size;
+        if (pos <= leftSize) {
+            _Index l, r;
+            _Split(_nodes[t].left, pos, &l, &r);
+            _nodes[t].left = r;
+            _Update(t);
+            *left = l;
+            *right = t;
+            return;
+        }
+        pos -= leftSize;
+        const size_t count = _nodes[t].run.count;
+        if (pos < count) {
+            // Give the tail this node's priority, so that both halves keep
+            // the heap order.
+            const _Index tail = _NewNode(
+                _SubRun(_nodes[t].run, pos, count - pos), _nodes[t].priority);
+            _nodes[tail].right = _nodes[t].right;
+            _Update(tail);
+            _nodes[t].run.count = pos;
+            _nodes[t].right = 0;
+            _Update(t);
+            *left = t;
+            *right = tail;
+            return;
+        }
+        _Index l, r;
+        _Split(_nodes[t].right, pos - count, &l, &r);
+        _nodes[t].right = l;
+        _Update(t);
+        *left = t;
+        *right = r;
+    }
+
+    // Return the tree with the elements of \p a followed by those of \p b.
+    _Index _Merge(_Index a, _Index b) {
+        if (!a || !b) {
+            return a ? a : b;
+        }
+        if (_nodes[a].priority >= _nodes[b].priority) {
+            const _Index r = _Merge(_nodes[a].right, b);
+            _nodes[a].right = r;
+            _Update(a);
+            return a;
+        }
+        const _Index l = _Merge(a, _nodes[b].left);
+        _nodes[b].left = l;
+        _Update(b);
+        return b;
+    }
+
+    // Remove and return the first run of the nonempty tree at \p t.
+    _Run _PopFront(_Index *t) {
+        _Index first = *t;
+        while (_nodes[first].left) {
+            first = _nodes[first].left;
+        }
+        const _Run run = _nodes[first].run;
+        _Index rest;
+        _Split(*t, run.count, &first, &rest);
+        _Free(first);
+        *t = rest;
+        return run;
+    }
+
+    // Remove and return the last run of the nonempty tree at \p t.
+    _Run _PopBack(_Index *t) {
+        _Index last = *t;
+        while (_nodes[last].right) {
+            last = _nodes[last].right;
+        }
+        const _Run run = _nodes[last].run;
+        _Index rest;
+        _Split(*t, _nodes[*t].size - run.count, &rest, &last);
+        _Free(last);
+        *t = rest;
+        return run;
+    }
+
+    // Append the parts of the runs in the tree at \p t, whose first element
+    // is at \p offset, that overlap [begin, end) to \p result.
+    void _Collect(_Index t, size_t offset, size_t begin, size_t end,
+                  _Runs *result) const {
+        if (!t || end <= offset || begin >= offset + _nodes[t].size) {
+            return;
+        }
+        _Node const &node = _nodes[t];
+        _Collect(node.left, offset, begin, end, result);
+        const size_t runBegin = offset + _nodes[node.left].size;
+        const size_t runEnd = runBegin + node.run.count;
+        const size_t b = std::max(begin, runBegin);
+        const size_t e = std::min(end, runEnd);
+        if (b < e) {
+            result->push_back(_SubRun(node.run, b - runBegin, e - b));
+        }
+        _Collect(node.right, runEnd, begin, end, result);
+    }
+
+    // Append all the runs in the tree at \p t to \p result.
+    void _Append(_Index t, _Runs *result) const {
+        if (t) {
+            _Append(_nodes[t].left, result);
+            result->push_back(_nodes[t].run);
+            _Append(_nodes[t].right, result);
+        }
+    }
+
+    std::vector<_Node> _nodes;
+    std::vector<_Index> _free;
+    _Index _root = 0;
+    uint32_t _seed = 2463534242u;
+};
+
+// Helpers for the compact encoding.  Integers are written as varints: 7 bits
+// per byte, low bits first, with the high bit set on all but the last byte.
+// Signed values are zigzag-encoded first, so small negative values are short
+// too.
+constexpr size_t _MaxVarintSize = 10;
+
+uint8_t *
+_PutVarint(uint64_t value, uint8_t *out)
+{
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+// Read a varint from [cur, end) into \p value and return a pointer past it.
+// Return nullptr if the input ends first or the varint exceeds 64 bits.
+uint8_t const *
+_GetVarint(uint8_t const *cur, uint8_t const *end, uint64_t *value)
+{
+    if (cur != end && !(*cur & 0x80)) {
+        *value = *cur++;
+        return cur;
+    }
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && cur != end; shift += 7) {
+        const uint8_t byte = *cur++;
+        result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return cur;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t
+_ZigZag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^
+        static_cast<uint64_t>(value >> 63);
+}
+
+int64_t
+_UnZigZag(uint64_t value)
+{
+    return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+}
+
+// Map index args so that EndIndex, which is INT64_MIN, sits just past -1 and
+// so encodes as briefly as other end-relative indexes.  Nonnegative values are
+// unchanged and -n becomes -n - 1.
+int64_t
+_ToWireArg(int64_t arg)
+{
+    return arg == Vt_ArrayEditOps::EndIndex ? -1 : arg < 0 ? arg - 1 : arg;
+}
+
+int64_t
+_FromWireArg(int64_t arg)
+{
+    return arg == -1 ? Vt_ArrayEditOps::EndIndex : arg < 0 ? arg + 1 : arg;
+}
+
+} // anon
+
+std::vector<Vt_ArrayEditOps::Run>
+Vt_ArrayEditOps::ComputeRuns(size_t numLiterals, size_t initialSize) const
+{
+    const _Run defaultFill { 0, 0, Run::Default };
+
+    _Layout layout(initialSize);
+    ForEachValid(numLiterals, initialSize,
+                 [&](Op op, int64_t a1, int64_t a2, int64_t a3) {
+        switch (op) {
+        case OpWriteLiteral: // a1: literal index -> a2: result index.
+            layout.Write(a2, { { a1, 1, Run::Literal } });
+            break;
+        case OpWriteRef: // a1: result index -> a2: result index.
+            layout.Write(a2, layout.Get(a1, 1));
+            break;
+        case OpInsertLiteral: // a1: literal index -> a2: result index.
+            layout.Insert(a2, { { a1, 1, Run::Literal } });
+            break;
+        case OpInsertRef: // a1: result index -> a2: result index.
+            layout.Insert(a2, layout.Get(a1, 1));
+            break;
+        case OpEraseRef: // a1: result index, (a2: unused)
+            layout.Erase(a1, 1);
+            break;
+        case OpMinSize:  // a1: minimum size, (a2: unused)
+            if (layout.GetSize() < static_cast<size_t>(a1)) {
+                layout.Resize(a1, defaultFill);
+            }
+            break;
+        case OpMinSizeFill:  // a1: minimum size, a2: literal index.
+            if (layout.GetSize() < static_cast<size_t>(a1)) {
+                layout.Resize(a1, { a2, 0, Run::Literal });
+            }
+            break;
+        case OpSetSize:  // a1: explicit size, (a2: unused)
+            layout.Resize(a1, defaultFill);
+            break;
+        case OpSetSizeFill:  // a1: explicit size, a2: literal index.
+            layout.Resize(a1, { a2, 0, Run::Literal });
+            break;
+        case OpMaxSize:  // a1: maximum size, a2: unused
+            if (layout.GetSize() > static_cast<size_t>(a1)) {
+                layout.Resize(a1, defaultFill);
+            }
+            break;
+        case OpWriteLiteralRange: // a1: literal index -> a2: index, a3: count
+            if (a3) {
+                layout.Write(a2, { { a1, a3, Run::Literals } });
+            }
+            break;
+        case OpWriteRefRange: // a1: result index -> a2: index, a3: count
+            layout.Write(a2, layout.Get(a1, a3));
+            break;
+        case OpInsertLiteralRange: // a1: literal index -> a2: index, a3: count
+            if (a3) {
+                layout.Insert(a2, { { a1, a3, Run::Literals } });
+            }
+            break;
+        case OpInsertRefRange: // a1: result index -> a2: index, a3: count
+            layout.Insert(a2, layout.Get(a1, a3));
+            break;
+        case OpEraseRange: // a1: result index, a2: count
+            layout.Erase(a1, a2);
+            break;
+        };
+    });
+    return layout.Release();
+}
+
+bool
+Vt_ArrayEditOps::PartitionWrites(size_t numLiterals, size_t size,
+                                 size_t minWrites,
+                                 std::vector<Write> *writes,
+                                 std::vector<size_t> *partitionEnds) const
+{
+    // Check that there are only writes, and count them.
+    size_t numWrites = 0;
+    bool hasRefs = false;
+    for (size_t i = 0; i < _ins.size(); ) {
+        const OpAndCount oc = _ToOpAndCount(_ins[i]);
+        const bool isRange =
+            oc.op == OpWriteLiteralRange || oc.op == OpWriteRefRange;
+        if (!isRange && oc.op != OpWriteLiteral && oc.op != OpWriteRef) {
+            return false;
+        }
+        hasRefs |= oc.op == OpWriteRef || oc.op == OpWriteRefRange;
+        const int arity = GetArity(oc.op);
+        if (oc.count < 0 ||
+            static_cast<uint64_t>(_ins.size() - i - 1) <
+            static_cast<uint64_t>(oc.count) * arity) {
+            // Leave malformed ops for the caller to report.
+            return false;
+        }
+        if (isRange) {
+            for (int64_t n = 0; n != oc.count; ++n) {
+                numWrites += std::max<int64_t>(_ins[i + 3 + n * arity], 0);
+            }
+        }
+        else {
+            numWrites += oc.count;
+        }
+        i += 1 + oc.count * arity;
+    }
+    if (numWrites < minWrites) {
+        return false;
+    }
+
+    // Use up to 256 partitions of at least 4096 elements.
+    int shift = 12;
+    while ((size >> shift) > 255) {
+        ++shift;
+    }
+    const size_t numPartitions = (size >> shift) + 1;
+
+    // Invoke fn(dst, src, isLiteral) for each element write in order.  Ref
+    // ranges that overlap their destination from below go backward, so that
+    // applying them in order copies as if through a temporary.
+    auto forEachWrite = [this, numLiterals, size](auto const &fn) {
+        ForEachValid(numLiterals, size,
+                     [&fn](Op op, int64_t a1, int64_t a2, int64_t a3) {
+            const bool isLiteral =
+                op == OpWriteLiteral || op == OpWriteLiteralRange;
+            if (op == OpWriteLiteral || op == OpWriteRef) {
+                fn(a2, a1, isLiteral);
+            }
+            else if (op == OpWriteRefRange && a1 < a2) {
+                for (int64_t j = a3; j--; ) {
+                    fn(a2 + j, a1 + j, false);
+                }
+            }
+            else {
+                for (int64_t j = 0; j != a3; ++j) {
+                    fn(a2 + j, a1 + j, isLiteral);
+                }
+            }
+        });
+    };
+
+    // Count the writes to each partition and, if there are references,
+    // note which elements are written.
+    std::vector<size_t> offsets(numPartitions + 1, 0);
+    std::vector<uint64_t> written(hasRefs ? (size + 63) / 64 : 0, 0);
+    forEachWrite([&offsets, &written, hasRefs, shift](
+                     int64_t dst, int64_t, bool) {
+        ++offsets[(dst >> shift) + 1];
+        if (hasRefs) {
+            written[dst / 64] |= uint64_t(1) << (dst % 64);
+        }
+    });
+    for (size_t p = 1; p != offsets.size(); ++p) {
+        offsets[p] += offsets[p - 1];
+    }
+    partitionEnds->assign(offsets.begin() + 1, offsets.end());
+
+    // Place each write in its partition.  A reference to an element in
+    // another partition is only safe if nothing writes that element, since
+    // otherwise its partition may or may not have written it yet.
+    writes->resize(offsets.back());
+    bool safe = true;
+    forEachWrite([&](int64_t dst, int64_t src, bool isLiteral) {
+        if (!isLiteral && (src >> shift) != (dst >> shift) &&
+            (written[src / 64] >> (src % 64)) & 1) {
+            safe = false;
+        }
+        (*writes)[offsets[dst >> shift]++] = { dst, src, isLiteral };
+    });
+    if (!safe) {
+        writes->clear();
+        partitionEnds->clear();
+    }
+    return safe;
+}
+
+void
+Vt_ArrayEditOps::Append(Vt_ArrayEditOps const &other, int64_t literalOffset)
+{
+    const size_t start = _ins.size();
+    _ins.insert(_ins.end(), other._ins.begin(), other._ins.end());
+    if (literalOffset == 0) {
+        return;
+    }
+
+    // Only visit the appended instructions.
+    _ForEachImpl(
+        -1, -1, TfSpan<int64_t>(_ins.data() + start, other._ins.size()),
+        [literalOffset](Op op, int64_t &a1, int64_t &a2, int64_t) {
+            switch (op) {
+            case OpWriteLiteral: // a1: literal index
+            case OpInsertLiteral:
+            case OpWriteLiteralRange:
+            case OpInsertLiteralRange:
+                a1 += literalOffset;
+                break;
+            case OpMinSizeFill: // a2: literal index
+            case OpSetSizeFill:
+                a2 += literalOffset;
+                break;
+            default:
+                break;
+            };
+        });
+}
+
+// The compact encoding is the number of 64-bit words in the instruction
+// stream, followed by each group of repeated ops: a varint holding the count
+// and op, then the args of each instruction in turn.  Each arg is stored as
+// the zigzag-encoded difference from the same arg of the previous instruction
+// with the same op, so sequential indexes, like those the builder produces for
+// consecutive writes and inserts, take a byte each.  See _ToWireArg() for the
+// treatment of negative indexes.
+void
+Vt_ArrayEditOps::EncodeCompact(std::vector<uint8_t> *out) const
+{
+    // Grow the output as needed to fit the worst case for each group of ops,
+    // then trim it at the end.
+    const size_t outStart = out->size();
+    uint8_t *dst = nullptr;
+    auto makeRoom = [out, &dst](size_t numWords) {
+        const size_t used = dst ? dst - out->data() : out->size();
+        const size_t required = used + _MaxVarintSize * numWords;
+        if (out->size() < required) {
+            out->resize(std::max(required, 2 * out->size()));
+        }
+        dst = out->data() + used;
+    };
+    makeRoom(1);
+    dst = _PutVarint(_ins.size(), dst);
+
+    uint64_t prev[NumOps][3] = {};
+    for (size_t i = 0; i != _ins.size(); ) {
+        const OpAndCount oc = _ToOpAndCount(_ins[i]);
+        if (!IsValidOp(oc.op) || oc.count < 0) {
+            _IssueInvalidOpError(oc, i);
+            out->resize(outStart);
+            return;
+        }
+        const int arity = GetArity(oc.op);
+        if (static_cast<uint64_t>(_ins.size() - ++i) <
+            static_cast<uint64_t>(oc.count) * arity) {
+            _IssueInvalidInsError(
+                oc, i, oc.count * arity, _ins.size() - i);
+            out->resize(outStart);
+            return;
+        }
+
+        makeRoom(1 + oc.count * arity);
+        dst = _PutVarint((static_cast<uint64_t>(oc.count) << 8) |
+                         static_cast<uint8_t>(oc.op), dst);
+        uint64_t *opPrev = prev[oc.op];
+        for (int64_t n = 0; n != oc.count; ++n) {
+            for (int j = 0; j != arity; ++j, ++i) {
+                const uint64_t arg =
+                    static_cast<uint64_t>(_ToWireArg(_ins[i]));
+                dst = _PutVarint(
+                    _ZigZag(static_cast<int64_t>(arg - opPrev[j])), dst);
+                opPrev[j] = arg;
+            }
+        }
+    }
+    out->resize(dst - out->data());
+}
+
+bool
+Vt_ArrayEditOps::DecodeCompact(TfSpan<const uint8_t> bytes)
+{
+    uint8_t const *const begin = bytes.data();
+    uint8_t const *const end = begin + bytes.size();
+
+    auto malformed = [this, begin, end](uint8_t const *at) {
+        TF_RUNTIME_ERROR("Malformed compact array edit data at byte %zd of "
+                         "%zd", static_cast<size_t>((at ? at : end) - begin),
+                         static_cast<size_t>(end - begin));
+        _ins.clear();
+        return false;
+    };
+
+    // Every word takes at least one byte, which bounds the allocation.
+    uint64_t numWords;
+    uint8_t const *cur = _GetVarint(begin, end, &numWords);
+    if (!cur || numWords > static_cast<uint64_t>(end - cur)) {
+        return malformed(cur);
+    }
+    _ins.resize(numWords);
+    int64_t *dst = _ins.data();
+    int64_t *const dstEnd = dst + numWords;
+
+    uint64_t prev[NumOps][3] = {};
+
+    while (cur != end) {
+        uint64_t header = 0;
+        uint8_t const *next = _GetVarint(cur, end, &header);
+        const Op op = static_cast<Op>(header & 0xff);
+        const uint64_t count = header >> 8;
+        if (!next || !IsValidOp(op) ||
+            count * GetArity(op) >= static_cast<uint64_t>(dstEnd - dst)) {
+            return malformed(cur);
+        }
+        cur = next;
+        *dst++ = _ToInt64({ static_cast<int64_t>(count), op });
+
+        const int arity = GetArity(op);
+        uint64_t *opPrev = prev[op];
+        for (uint64_t n = 0; n != count; ++n) {
+            for (int j = 0; j != arity; ++j) {
+                uint64_t delta;
+                if (!(cur = _GetVarint(cur, end, &delta))) {
+                    return malformed(cur);
+                }
+                opPrev[j] += static_cast<uint64_t>(_UnZigZag(delta));
+                *dst++ = _FromWireArg(static_cast<int64_t>(opPrev[j]));
+            }
+        }
+    }
+
+    if (dst != dstEnd) {
+        return malformed(cur);
+    }
+    return true;
 }
 
 void
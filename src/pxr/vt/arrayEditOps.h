@@ -14,11 +14,13 @@
 #include "pxr/vt/api.h"
 
 #include <pxr/tf/hash.h>
+#include <pxr/tf/span.h>
 
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 VT_NAMESPACE_OPEN_SCOPE
@@ -46,17 +48,30 @@ public:
         OpSetSize,       // resize <size>
         OpSetSizeFill,   // resize <size> <literal>
         OpMaxSize,       // maxsize <size>
+
+        // Range ops.  These take a count, and act on that many consecutive
+        // literals or elements.
+        OpWriteLiteralRange,  // write <literals> to [index] <count>
+        OpWriteRefRange,      // write [index1] to [index2] <count>
+        OpInsertLiteralRange, // insert <literals> at [index] <count>
+        OpInsertRefRange,     // insert [index1] at [index2] <count>
+        OpEraseRange,         // erase [index] <count>
     };
-    static constexpr uint8_t NumOps = OpMaxSize + 1;
+    static constexpr uint8_t NumOps = OpEraseRange + 1;
     
     static constexpr bool IsValidOp(Op op) {
         return op >= static_cast<Op>(0) && op < NumOps;
     }
 
     static constexpr int GetArity(Op op) {
+        if (op == OpWriteLiteralRange || op == OpWriteRefRange ||
+            op == OpInsertLiteralRange || op == OpInsertRefRange) {
+            return 3;
+        }
         if (op == OpWriteLiteral || op == OpWriteRef ||
             op == OpInsertLiteral || op == OpInsertRef ||
-            op == OpMinSizeFill || op == OpSetSizeFill) {
+            op == OpMinSizeFill || op == OpSetSizeFill ||
+            op == OpEraseRange) {
             return 2;
         }
         return 1;
@@ -69,25 +84,26 @@ public:
     };
     static_assert(sizeof(OpAndCount) == sizeof(int64_t));
 
-    // Invoke fn(Op, arg1, arg2) for each valid instruction.  Normalize index
-    // args according to initialSize (if negative or EndIndex).  Invalid
-    // instructions with out-of-bounds indexes are skipped.
+    // Invoke fn(Op, arg1, arg2, arg3) for each valid instruction.  Normalize
+    // index args according to initialSize (if negative or EndIndex).  Invalid
+    // instructions with out-of-bounds indexes or ranges are skipped.  Unused
+    // args are passed as -1.
     template <class Fn>
     void ForEachValid(size_t numLiterals, size_t initialSize, Fn &&fn) const {
         return _ForEachImpl(numLiterals, initialSize, _ins,
                             std::forward<Fn>(fn));
     }
 
-    // Invoke fn(Op, arg1, arg2) for each instruction as-is, with no index
-    // normalization or range checking.
+    // Invoke fn(Op, arg1, arg2, arg3) for each instruction as-is, with no
+    // index normalization or range checking.
     template <class Fn>
     void ForEach(Fn &&fn) const {
         return _ForEachImpl(-1, -1, _ins, std::forward<Fn>(fn));
     }
         
-    // Invoke fn(Op, arg1, arg2) for each instruction as-is, with no index
-    // normalization or range checking, and passing mutable references for arg1
-    // and arg2 to fn().  This lets fn() modify indexes if desired.
+    // Invoke fn(Op, arg1, arg2, arg3) for each instruction as-is, with no
+    // index normalization or range checking, and passing mutable references
+    // for the args to fn().  This lets fn() modify indexes if desired.
     template <class Fn>
     void ModifyEach(Fn &&fn) {
         return _ForEachImpl(-1, -1, _ins, std::forward<Fn>(fn));
@@ -98,6 +114,102 @@ public:
         return _ins.empty();
     }
 
+    // Append \p other's instructions, adding \p literalOffset to the literal
+    // indexes they refer to.
+    VT_API
+    void Append(Vt_ArrayEditOps const &other, int64_t literalOffset);
+
+    // Append a compact byte encoding of the instructions to \p out, for
+    // storage or transmission.  Indexes and counts are written as
+    // variable-length integers, mostly as differences from the previous
+    // instruction's, so they typically take one or two bytes rather than
+    // eight.
+    VT_API
+    void EncodeCompact(std::vector<uint8_t> *out) const;
+
+    // Replace the instructions with those decoded from \p bytes, as produced
+    // by EncodeCompact().  If \p bytes is malformed, issue a runtime error,
+    // leave no instructions, and return false.
+    VT_API
+    bool DecodeCompact(TfSpan<const uint8_t> bytes);
+
+    // Return true if any instruction inserts or erases elements, shifting
+    // the elements that follow.
+    bool HasInsertOrErase() const {
+        for (size_t i = 0; i < _ins.size(); ) {
+            const OpAndCount oc = _ToOpAndCount(_ins[i]);
+            if (!IsValidOp(oc.op)) {
+                return false;
+            }
+            if (oc.op == OpInsertLiteral || oc.op == OpInsertRef ||
+                oc.op == OpEraseRef || oc.op == OpInsertLiteralRange ||
+                oc.op == OpInsertRefRange || oc.op == OpEraseRange) {
+                return true;
+            }
+            i += 1 + oc.count * GetArity(oc.op);
+        }
+        return false;
+    }
+
+    // A run of consecutive elements in the result of applying ops to an
+    // array.  See ComputeRuns().
+    struct Run {
+        enum Kind : uint8_t {
+            Source,  // elements [index, index + count) of the input array
+            Literal, // count copies of literal <index>
+            Default, // count value-initialized elements
+            Literals // literals [index, index + count)
+        };
+        int64_t index;
+        int64_t count;
+        Kind kind;
+    };
+
+    // Compute the result of applying the ops to an array of initialSize
+    // elements as a sequence of runs, without touching any elements.  This
+    // lets callers build the result in a single pass rather than shuffling
+    // elements for every insert and erase.  Each instruction costs expected
+    // time logarithmic in the number of runs, which is bounded by both the
+    // working size of the array and one more than twice the number of
+    // instructions, plus time proportional to the number of runs it reads.
+    VT_API
+    std::vector<Run> ComputeRuns(size_t numLiterals, size_t initialSize) const;
+
+    // Return true if \p runs, as computed by ComputeRuns() for an array of
+    // \p initialSize elements, leave the array unchanged.
+    static bool IsPassThrough(std::vector<Run> const &runs,
+                              size_t initialSize) {
+        if (runs.empty()) {
+            return initialSize == 0;
+        }
+        return runs.size() == 1 &&
+            runs[0].kind == Run::Source &&
+            runs[0].index == 0 &&
+            static_cast<size_t>(runs[0].count) == initialSize;
+    }
+
+    // A write of literal or element \p src to element \p dst.  See
+    // PartitionWrites().
+    struct Write {
+        int64_t dst;
+        int64_t src;
+        bool isLiteral;
+    };
+
+    // If the ops only write elements and do at least \p minWrites element
+    // writes, split them by destination into partitions that can be applied
+    // independently, and return true.  Store the writes in \p writes grouped
+    // by partition, each in its original order, and the end of each
+    // partition's writes in \p partitionEnds.  A partition's writes only
+    // write and read elements in that partition, or read elements that
+    // nothing writes, so applying each partition's writes in order, with
+    // partitions in parallel, gives the same result as applying the ops in
+    // order.  If that cannot be guaranteed, return false.
+    VT_API
+    bool PartitionWrites(size_t numLiterals, size_t size, size_t minWrites,
+                         std::vector<Write> *writes,
+                         std::vector<size_t> *partitionEnds) const;
+
 private:
     template <class ELEM>
     friend class VtArrayEdit;
@@ -187,6 +299,32 @@ private:
         return false;
     }
 
+    static bool _CheckLiteralRange(int64_t idx, int64_t count, size_t size) {
+        if (size == _DisableBoundsCheck ||
+            (idx >= 0 && static_cast<size_t>(idx) <= size &&
+             static_cast<size_t>(count) <= size - idx)) {
+            return true;
+        }
+        _LiteralOutOfBounds(idx, size);
+        return false;
+    }
+
+    static bool _NormalizeAndCheckRefRange(
+        int64_t &idx, int64_t count, size_t size) {
+        if (size == _DisableBoundsCheck) {
+            return true;
+        }
+        if (idx < 0) {
+            idx += size;
+        }
+        if (idx >= 0 && static_cast<size_t>(idx) <= size &&
+            static_cast<size_t>(count) <= size - idx) {
+            return true;
+        }
+        _ReferenceOutOfBounds(idx, size);
+        return false;
+    }
+
     static bool _CheckSizeArg(Op op, int64_t arg) {
         if (arg < 0) {
             _NegativeSizeArg(op, arg);
@@ -232,6 +370,7 @@ private:
             for (; oc.count--; iter += arity) {
                 int64_t a1 = iter[0];
                 int64_t a2 = arity > 1 ? iter[1] : -1;
+                int64_t a3 = arity > 2 ? iter[2] : -1;
 
                 // Normalize and check indexes if requested.
                 switch (oc.op) {
@@ -303,11 +442,61 @@ private:
                         initialSize,
                         std::min(initialSize, static_cast<size_t>(a1)));
                     break;
+
+                case OpWriteLiteralRange:
+                    if (!_CheckSizeArg(oc.op, a3) ||
+                        !_CheckLiteralRange(a1, a3, numLiterals) ||
+                        !_NormalizeAndCheckRefRange(a2, a3, initialSize)) {
+                        continue;
+                    }
+                    break;
+                case OpWriteRefRange:
+                    if (!_CheckSizeArg(oc.op, a3) ||
+                        !_NormalizeAndCheckRefRange(a1, a3, initialSize) ||
+                        !_NormalizeAndCheckRefRange(a2, a3, initialSize)) {
+                        continue;
+                    }
+                    break;
+                case OpInsertLiteralRange:
+                    if (!_CheckSizeArg(oc.op, a3) ||
+                        !_CheckLiteralRange(a1, a3, numLiterals) ||
+                        !_NormalizeAndCheckInsertIndex(a2, initialSize)) {
+                        continue;
+                    }
+                    _UpdateWorkingSize(initialSize, initialSize + a3);
+                    break;
+                case OpInsertRefRange:
+                    if (!_CheckSizeArg(oc.op, a3) ||
+                        !_NormalizeAndCheckRefRange(a1, a3, initialSize) ||
+                        !_NormalizeAndCheckInsertIndex(a2, initialSize)) {
+                        continue;
+                    }
+                    _UpdateWorkingSize(initialSize, initialSize + a3);
+                    break;
+                case OpEraseRange:
+                    if (!_CheckSizeArg(oc.op, a2) ||
+                        !_NormalizeAndCheckRefRange(a1, a2, initialSize)) {
+                        continue;
+                    }
+                    _UpdateWorkingSize(initialSize, initialSize - a2);
+                    break;
                     
                 };
 
                 // Invoke caller.
-                std::forward<Fn>(fn)(oc.op, a1, a2);
+                std::forward<Fn>(fn)(oc.op, a1, a2, a3);
+
+                // Store back any modifications made by ModifyEach() callers.
+                if constexpr (!std::is_const_v<
+                              std::remove_reference_t<decltype(*iter)>>) {
+                    iter[0] = a1;
+                    if (arity > 1) {
+                        iter[1] = a2;
+                    }
+                    if (arity > 2) {
+                        iter[2] = a3;
+                    }
+                }
             }
         }
     }
@@ -331,7 +520,8 @@ private:
     // the op itself.  For example, in the case of [2 OpWriteLiteral], there are
     // four quantities that follow, two for each instruction: a literal index
     // and a destination index.  The GetArity() member function returns the
-    // arity for a given op.  Currently either 1 or 2.
+    // arity for a given op.  Currently 1, 2, or 3 for the range ops, which
+    // take a count last (or second, for OpEraseRange).
     std::vector<int64_t> _ins;
 
 };
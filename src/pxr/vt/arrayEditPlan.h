@@ -0,0 +1,263 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_VT_ARRAY_EDIT_PLAN_H
+#define PXR_VT_ARRAY_EDIT_PLAN_H
+
+/// \file vt/arrayEditPlan.h
+
+#include "pxr/vt/pxr.h"
+#include "pxr/vt/array.h"
+#include "pxr/vt/arrayEdit.h"
+#include "pxr/vt/arrayEditOps.h"
+
+#include <pxr/tf/span.h>
+#include <pxr/trace/trace.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <vector>
+
+VT_NAMESPACE_OPEN_SCOPE
+
+/// \class VtArrayEditPlan
+///
+/// A VtArrayEdit compiled against a known input array size, for applying the
+/// same edit to many arrays of that size, such as the time samples of one
+/// attribute.
+///
+/// Construction does all the work that depends only on the input size:
+/// negative and end indexes are resolved, out-of-bounds instructions are
+/// dropped, and the resulting layout of input elements and literals, and so
+/// the output size, is computed.  Apply() then builds each result in a single
+/// pass.  Edits that only write elements and resize are instead resolved into
+/// a final resize and a list of element writes at absolute indexes, which
+/// Apply() performs in place.  Arrays of any other size are handled by
+/// applying the edit as VtArrayEdit::ComposeOver() would.
+///
+template <class ELEM>
+class VtArrayEditPlan
+{
+public:
+    using Edit = VtArrayEdit<ELEM>;
+    using Array = typename Edit::Array;
+    using ElementType = typename Edit::ElementType;
+
+    /// Construct a plan that applies no edits to arrays of size 0.
+    VtArrayEditPlan() = default;
+
+    /// Compile \p edit for application to arrays of \p inputSize elements.
+    VtArrayEditPlan(Edit const &edit, size_t inputSize)
+        : _edit(edit)
+        , _inputSize(inputSize) {
+        TRACE_FUNCTION();
+        if (_edit.IsDenseArray()) {
+            _outputSize = _edit._denseOrLiterals.size();
+            return;
+        }
+        const size_t numLiterals = _edit._denseOrLiterals.size();
+        if (!_edit._ops.HasInsertOrErase()) {
+            _isResolved = _ResolveWritesAndResizes(numLiterals);
+            _applyEdits = !_isResolved;
+            return;
+        }
+        _runs = _edit._ops.ComputeRuns(numLiterals, inputSize);
+        _outputSize = 0;
+        for (Vt_ArrayEditOps::Run const &run: _runs) {
+            _outputSize += run.count;
+        }
+        _isPassThrough = Vt_ArrayEditOps::IsPassThrough(_runs, inputSize);
+    }
+
+    /// Return the input array size this plan was compiled for.
+    size_t GetInputSize() const {
+        return _inputSize;
+    }
+
+    /// Return the size of the arrays produced by applying this plan to arrays
+    /// of GetInputSize() elements.
+    size_t GetOutputSize() const {
+        return _outputSize;
+    }
+
+    /// Return the result of applying the edit to \p array.  This is
+    /// equivalent to edit.ComposeOver(array).GetDenseArray(), but is cheaper
+    /// if \p array has GetInputSize() elements.  If the edit leaves such
+    /// arrays unchanged, return \p array itself, sharing its data.
+    Array Apply(Array const &array) const {
+        if (_edit.IsDenseArray()) {
+            return _edit._denseOrLiterals;
+        }
+        if (array.size() != _inputSize) {
+            return _edit.ComposeOver(array).GetDenseArray();
+        }
+        if (_isPassThrough) {
+            return array;
+        }
+        if (_applyEdits) {
+            return _edit._ApplyEdits(array);
+        }
+        if (_isResolved) {
+            return _ApplyResolvedWrites(array);
+        }
+        return Edit::_BuildFromRuns(array, _edit._denseOrLiterals, _runs);
+    }
+
+    /// Replace each array in \p arrays with the result of Apply(), working on
+    /// several arrays in parallel.
+    void ApplyToEach(TfSpan<Array> arrays) const {
+        TRACE_FUNCTION();
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, arrays.size()),
+            [this, &arrays](tbb::blocked_range<size_t> const &r) {
+                for (size_t i = r.begin(); i != r.end(); ++i) {
+                    arrays[i] = Apply(arrays[i]);
+                }
+            });
+    }
+
+private:
+    // A stretch of elements that resizing added at [begin, end), filled with
+    // a literal, or value-initialized if literal is negative.
+    struct _Fill {
+        size_t begin;
+        size_t end;
+        int64_t literal;
+    };
+
+    // Resolve an edit that only writes and resizes into the part of the
+    // input it keeps, the fills that follow, and the element writes to
+    // perform after them, in order.  Return false if a write reads an
+    // element that a later resize drops, since performing the writes after
+    // the final resize would then read a different value.
+    bool _ResolveWritesAndResizes(size_t numLiterals) {
+        using _Ops = Vt_ArrayEditOps;
+        size_t size = _inputSize;
+        _keepSize = _inputSize;
+        bool resolved = true;
+
+        const auto resize = [&](size_t newSize, int64_t literal) {
+            if (newSize > size) {
+                _fills.push_back({ size, newSize, literal });
+            }
+            else if (newSize < size) {
+                _keepSize = std::min(_keepSize, newSize);
+                while (!_fills.empty() && _fills.back().begin >= newSize) {
+                    _fills.pop_back();
+                }
+                if (!_fills.empty()) {
+                    _fills.back().end = newSize;
+                }
+                _writes.erase(
+                    std::remove_if(_writes.begin(), _writes.end(),
+                                   [newSize](_Ops::Write const &w) {
+                                       return w.dst >= int64_t(newSize);
+                                   }), _writes.end());
+                for (_Ops::Write const &w: _writes) {
+                    if (!w.isLiteral && w.src >= int64_t(newSize)) {
+                        resolved = false;
+                    }
+                }
+            }
+            size = newSize;
+        };
+
+        _edit._ops.ForEachValid(numLiterals, _inputSize,
+        [&](_Ops::Op op, int64_t a1, int64_t a2, int64_t a3) {
+            switch (op) {
+            case _Ops::OpWriteLiteral:
+            case _Ops::OpWriteRef:
+                _writes.push_back({ a2, a1, op == _Ops::OpWriteLiteral });
+                break;
+            case _Ops::OpWriteLiteralRange:
+                for (int64_t j = 0; j != a3; ++j) {
+                    _writes.push_back({ a2 + j, a1 + j, true });
+                }
+                break;
+            case _Ops::OpWriteRefRange:
+                // Overlapping ranges copy as if through a temporary.
+                if (a1 < a2) {
+                    for (int64_t j = a3; j--; ) {
+                        _writes.push_back({ a2 + j, a1 + j, false });
+                    }
+                }
+                else {
+                    for (int64_t j = 0; j != a3; ++j) {
+                        _writes.push_back({ a2 + j, a1 + j, false });
+                    }
+                }
+                break;
+            case _Ops::OpMinSize:
+                resize(std::max<size_t>(size, a1), -1);
+                break;
+            case _Ops::OpMinSizeFill:
+                resize(std::max<size_t>(size, a1), a2);
+                break;
+            case _Ops::OpSetSize:
+                resize(a1, -1);
+                break;
+            case _Ops::OpSetSizeFill:
+                resize(a1, a2);
+                break;
+            case _Ops::OpMaxSize:
+                resize(std::min<size_t>(size, a1), -1);
+                break;
+            default:
+                // Inserts and erases are handled by _BuildFromRuns().
+                break;
+            };
+        });
+
+        _outputSize = size;
+        _isPassThrough =
+            _writes.empty() && _fills.empty() && _keepSize == _inputSize;
+        return resolved;
+    }
+
+    // Return the result of performing the resolved resizes and writes on
+    // \p array.
+    Array _ApplyResolvedWrites(Array const &array) const {
+        Array const &literals = _edit._denseOrLiterals;
+        Array result = array;
+        if (_keepSize != _inputSize || !_fills.empty()) {
+            result.resize(_keepSize);
+            for (_Fill const &fill: _fills) {
+                if (fill.literal < 0) {
+                    result.resize(fill.end);
+                }
+                else {
+                    result.resize(fill.end, literals[fill.literal]);
+                }
+            }
+        }
+        if (!_writes.empty()) {
+            ELEM *data = result.data();
+            ELEM const *literalData = literals.cdata();
+            for (Vt_ArrayEditOps::Write const &w: _writes) {
+                data[w.dst] = w.isLiteral ? literalData[w.src] : data[w.src];
+            }
+        }
+        return result;
+    }
+
+    Edit _edit;
+    std::vector<Vt_ArrayEditOps::Run> _runs;
+    std::vector<Vt_ArrayEditOps::Write> _writes;
+    std::vector<_Fill> _fills;
+    size_t _inputSize = 0;
+    size_t _outputSize = 0;
+    size_t _keepSize = 0;
+    bool _isPassThrough = true;
+    bool _isResolved = false;
+    bool _applyEdits = false;
+};
+
+VT_NAMESPACE_CLOSE_SCOPE
+
+#endif // PXR_VT_ARRAY_EDIT_PLAN_H
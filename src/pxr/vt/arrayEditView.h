@@ -0,0 +1,128 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_VT_ARRAY_EDIT_VIEW_H
+#define PXR_VT_ARRAY_EDIT_VIEW_H
+
+/// \file vt/arrayEditView.h
+
+#include "pxr/vt/pxr.h"
+#include "pxr/vt/array.h"
+#include "pxr/vt/arrayEdit.h"
+#include "pxr/vt/arrayEditOps.h"
+
+#include <pxr/trace/trace.h>
+
+#include <algorithm>
+#include <vector>
+
+VT_NAMESPACE_OPEN_SCOPE
+
+/// \class VtArrayEditView
+///
+/// A read-only view of the result of composing a VtArrayEdit over a base
+/// array, without materializing it.
+///
+/// Construction computes where each stretch of the result comes from -- the
+/// base array, the edit's literals, or value-initialized elements.  For an
+/// edit of K instructions this takes expected O(K log K) time, independent of
+/// the size of the base array.  Then size() and operator[] read elements
+/// straight from the base array and the edit.  GetDenseArray() builds the
+/// full result only when it is actually needed.
+///
+/// The view holds its own references to the edit and the base array, so it
+/// remains valid regardless of what happens to the objects it was constructed
+/// from.
+///
+template <class ELEM>
+class VtArrayEditView
+{
+public:
+    using Edit = VtArrayEdit<ELEM>;
+    using Array = typename Edit::Array;
+    using ElementType = typename Edit::ElementType;
+
+    /// Construct a view of an empty array.
+    VtArrayEditView() = default;
+
+    /// Construct a view of the result of composing \p edit over \p base.
+    VtArrayEditView(Edit const &edit, Array const &base)
+        : _edit(edit)
+        , _base(base) {
+        TRACE_FUNCTION();
+        if (_edit.IsDenseArray()) {
+            _size = _edit._denseOrLiterals.size();
+            return;
+        }
+        _runs = _edit._ops.ComputeRuns(
+            _edit._denseOrLiterals.size(), _base.size());
+        _runEnds.reserve(_runs.size());
+        for (Vt_ArrayEditOps::Run const &run: _runs) {
+            _size += run.count;
+            _runEnds.push_back(_size);
+        }
+    }
+
+    /// Return the number of elements in the composed result.
+    size_t size() const {
+        return _size;
+    }
+
+    /// Return true if the composed result has no elements.
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /// Return the element at \p index in the composed result, which must be
+    /// less than size().  This takes time logarithmic in the number of edits.
+    ElementType const &operator[](size_t index) const {
+        if (_edit.IsDenseArray()) {
+            return _edit._denseOrLiterals[index];
+        }
+        const size_t i = std::upper_bound(
+            _runEnds.begin(), _runEnds.end(), index) - _runEnds.begin();
+        Vt_ArrayEditOps::Run const &run = _runs[i];
+        const size_t offset = index - (_runEnds[i] - run.count);
+        switch (run.kind) {
+        case Vt_ArrayEditOps::Run::Source:
+            return _base[run.index + offset];
+        case Vt_ArrayEditOps::Run::Literal:
+            return _edit._denseOrLiterals[run.index];
+        case Vt_ArrayEditOps::Run::Literals:
+            return _edit._denseOrLiterals[run.index + offset];
+        case Vt_ArrayEditOps::Run::Default:
+            break;
+        };
+        static const ElementType defaultElem {};
+        return defaultElem;
+    }
+
+    /// Return the composed result as an array.  This is equivalent to
+    /// edit.ComposeOver(base).GetDenseArray().  If the edit leaves the base
+    /// array unchanged, return the base array itself, sharing its data.
+    Array GetDenseArray() const {
+        if (_edit.IsDenseArray()) {
+            return _edit._denseOrLiterals;
+        }
+        if (Vt_ArrayEditOps::IsPassThrough(_runs, _base.size())) {
+            return _base;
+        }
+        return Edit::_BuildFromRuns(_base, _edit._denseOrLiterals, _runs);
+    }
+
+private:
+    Edit _edit;
+    Array _base;
+    std::vector<Vt_ArrayEditOps::Run> _runs;
+    // The end offset of each run in the composed result.
+    std::vector<size_t> _runEnds;
+    size_t _size = 0;
+};
+
+VT_NAMESPACE_CLOSE_SCOPE
+
+#endif // PXR_VT_ARRAY_EDIT_VIEW_H
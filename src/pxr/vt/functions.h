@@ -0,0 +1,1509 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_VT_FUNCTIONS_H
+#define PXR_VT_FUNCTIONS_H
+
+/// \file vt/functions.h
+/// Bulk algorithms over VtArray.
+///
+/// The functions in this file complement the element-wise operators declared
+/// in array.h.  They operate on whole arrays at once, process large arrays in
+/// parallel, and use flat inner loops over the underlying scalars for
+/// arithmetic element types and Gf vectors of arithmetic scalars so that the
+/// compiler can vectorize them.
+
+#include "pxr/vt/pxr.h"
+#include "pxr/vt/api.h"
+#include "pxr/vt/array.h"
+#include "pxr/vt/types.h"
+
+#include <pxr/arch/defines.h>
+#include <pxr/gf/dualQuatd.h>
+#include <pxr/gf/dualQuatf.h>
+#include <pxr/gf/dualQuath.h>
+#include <pxr/gf/matrix4d.h>
+#include <pxr/gf/quatd.h>
+#include <pxr/gf/quatf.h>
+#include <pxr/gf/quath.h>
+#include <pxr/gf/range1d.h>
+#include <pxr/gf/range1f.h>
+#include <pxr/gf/range2d.h>
+#include <pxr/gf/range2f.h>
+#include <pxr/gf/range3d.h>
+#include <pxr/gf/range3f.h>
+#include <pxr/gf/traits.h>
+#include <pxr/gf/vec2d.h>
+#include <pxr/gf/vec2f.h>
+#include <pxr/gf/vec3d.h>
+#include <pxr/gf/vec3f.h>
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/hash.h>
+#include <pxr/trace/trace.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+VT_NAMESPACE_OPEN_SCOPE
+
+namespace Vt_FunctionsDetail {
+
+// Arrays with fewer than twice this many elements are processed serially.
+// Below that, the cost of dispatching to worker threads exceeds the work.
+constexpr size_t GrainSize = 16384;
+
+using Range = tbb::blocked_range<size_t>;
+
+// Invoke fn(begin, end) over subranges covering [0, n), in parallel if n is
+// large enough to benefit.
+template <class Fn>
+void
+ParallelFor(size_t n, Fn &&fn)
+{
+    if (n < 2 * GrainSize) {
+        if (n) {
+            fn(size_t(0), n);
+        }
+        return;
+    }
+    tbb::parallel_for(Range(0, n, GrainSize), [&fn](Range const &r) {
+        fn(r.begin(), r.end());
+    });
+}
+
+// Invoke fn(block, begin, end) for each of the consecutive blocks of
+// GrainSize elements that cover [0, n), in parallel if there are several.
+// Unlike ParallelFor(), the block boundaries depend only on n, so results can
+// be computed per block and combined afterward.
+inline size_t
+NumBlocks(size_t n)
+{
+    return (n + GrainSize - 1) / GrainSize;
+}
+
+template <class Fn>
+void
+ParallelForBlocks(size_t n, Fn &&fn)
+{
+    const size_t numBlocks = NumBlocks(n);
+    auto runBlock = [n, &fn](size_t block) {
+        const size_t b = block * GrainSize;
+        fn(block, b, std::min(n, b + GrainSize));
+    };
+    if (numBlocks < 2) {
+        if (numBlocks) {
+            runBlock(0);
+        }
+        return;
+    }
+    tbb::parallel_for(size_t(0), numBlocks, runBlock);
+}
+
+// Reduce [0, n) by invoking chunk(begin, end, acc) -> T over subranges and
+// combining partial results with join(T, T) -> T.  If deterministic is true,
+// the subranges and the order in which partial results are joined depend
+// only on n, so floating point results are reproducible from run to run.
+template <class T, class Chunk, class Join>
+T
+ParallelReduce(size_t n, T const &identity, Chunk &&chunk, Join &&join,
+               bool deterministic)
+{
+    if (n < 2 * GrainSize) {
+        return chunk(size_t(0), n, identity);
+    }
+    auto body = [&chunk](Range const &r, T const &acc) {
+        return chunk(r.begin(), r.end(), acc);
+    };
+    return deterministic
+        ? tbb::parallel_deterministic_reduce(
+            Range(0, n, GrainSize), identity, body, join)
+        : tbb::parallel_reduce(
+            Range(0, n, GrainSize), identity, body, join);
+}
+
+// Describes element types that can be processed as a flat run of arithmetic
+// scalars: builtin arithmetic types other than bool, and Gf vectors of them.
+template <class T, class = void>
+struct FlatTraits {
+    static constexpr bool IsFlat = false;
+};
+
+template <class T>
+struct FlatTraits<T, std::enable_if_t<
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr bool IsFlat = true;
+    using Scalar = T;
+    static constexpr size_t Dim = 1;
+};
+
+template <class T>
+struct FlatTraits<T, std::enable_if_t<
+    GfIsGfVec<T>::value &&
+    std::is_arithmetic_v<typename T::ScalarType>>> {
+    static constexpr bool IsFlat = true;
+    using Scalar = typename T::ScalarType;
+    static constexpr size_t Dim = T::dimension;
+};
+
+template <class T>
+constexpr bool IsFlat = FlatTraits<T>::IsFlat;
+
+// The number of independent accumulators the flat kernels keep.  Using
+// several breaks the loop-carried dependency on a single accumulator, which
+// lets the compiler keep them in vector registers without reassociating
+// floating point math.  It is a multiple of Dim so that each accumulator
+// always sees the same vector component.
+template <class T>
+constexpr size_t NumLanes = std::lcm(size_t(8), FlatTraits<T>::Dim);
+
+template <class T>
+typename FlatTraits<T>::Scalar const *
+AsScalars(T const *p)
+{
+    static_assert(sizeof(T) ==
+                  sizeof(typename FlatTraits<T>::Scalar) *
+                  FlatTraits<T>::Dim);
+    return reinterpret_cast<typename FlatTraits<T>::Scalar const *>(p);
+}
+
+template <class T>
+typename FlatTraits<T>::Scalar *
+AsScalars(T *p)
+{
+    static_assert(sizeof(T) ==
+                  sizeof(typename FlatTraits<T>::Scalar) *
+                  FlatTraits<T>::Dim);
+    return reinterpret_cast<typename FlatTraits<T>::Scalar *>(p);
+}
+
+// Component-wise minimum and maximum, so that Gf vectors of types without a
+// flat representation (GfHalf) still reduce sensibly.
+template <class T>
+T
+Min(T const &a, T const &b)
+{
+    if constexpr (GfIsGfVec<T>::value) {
+        T r = a;
+        for (size_t i = 0; i != T::dimension; ++i) {
+            if (b[i] < r[i]) {
+                r[i] = b[i];
+            }
+        }
+        return r;
+    }
+    else {
+        return b < a ? b : a;
+    }
+}
+
+template <class T>
+T
+Max(T const &a, T const &b)
+{
+    if constexpr (GfIsGfVec<T>::value) {
+        T r = a;
+        for (size_t i = 0; i != T::dimension; ++i) {
+            if (r[i] < b[i]) {
+                r[i] = b[i];
+            }
+        }
+        return r;
+    }
+    else {
+        return a < b ? b : a;
+    }
+}
+
+// Sum elements [b, e) of data onto acc.
+template <class T>
+T
+SumChunk(T const *data, size_t b, size_t e, T acc)
+{
+    if constexpr (IsFlat<T>) {
+        using S = typename FlatTraits<T>::Scalar;
+        constexpr size_t D = FlatTraits<T>::Dim;
+        constexpr size_t L = NumLanes<T>;
+        S const *p = AsScalars(data + b);
+        const size_t n = (e - b) * D;
+        S lanes[L] = {};
+        size_t i = 0;
+        for (; i + L <= n; i += L) {
+            for (size_t k = 0; k != L; ++k) {
+                lanes[k] += p[i + k];
+            }
+        }
+        for (size_t k = 0; i != n; ++i, ++k) {
+            lanes[k] += p[i];
+        }
+        S *out = AsScalars(&acc);
+        for (size_t k = 0; k != L; ++k) {
+            out[k % D] += lanes[k];
+        }
+        return acc;
+    }
+    else {
+        for (T const *p = data + b, *end = data + e; p != end; ++p) {
+            acc = acc + *p;
+        }
+        return acc;
+    }
+}
+
+// Sum the products of the scalars of elements [b, e) of a and b onto acc.
+template <class T>
+typename FlatTraits<T>::Scalar
+DotChunk(T const *a, T const *b, size_t first, size_t last,
+         typename FlatTraits<T>::Scalar acc)
+{
+    using S = typename FlatTraits<T>::Scalar;
+    constexpr size_t D = FlatTraits<T>::Dim;
+    constexpr size_t L = NumLanes<T>;
+    S const *pa = AsScalars(a + first);
+    S const *pb = AsScalars(b + first);
+    const size_t n = (last - first) * D;
+    S lanes[L] = {};
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+        for (size_t k = 0; k != L; ++k) {
+            lanes[k] += pa[i + k] * pb[i + k];
+        }
+    }
+    for (size_t k = 0; i != n; ++i, ++k) {
+        lanes[k] += pa[i] * pb[i];
+    }
+    for (size_t k = 0; k != L; ++k) {
+        acc += lanes[k];
+    }
+    return acc;
+}
+
+// Fold elements [b, e) of data into the running minimum and maximum in
+// minMax[0] and minMax[1].  Requires b < e.
+template <class T>
+void
+MinMaxChunk(T const *data, size_t b, size_t e, T *minMax)
+{
+    if constexpr (IsFlat<T>) {
+        using S = typename FlatTraits<T>::Scalar;
+        constexpr size_t D = FlatTraits<T>::Dim;
+        constexpr size_t L = NumLanes<T>;
+        S const *p = AsScalars(data + b);
+        const size_t n = (e - b) * D;
+        S *lo = AsScalars(&minMax[0]);
+        S *hi = AsScalars(&minMax[1]);
+        S lanesLo[L], lanesHi[L];
+        for (size_t k = 0; k != L; ++k) {
+            lanesLo[k] = lo[k % D];
+            lanesHi[k] = hi[k % D];
+        }
+        size_t i = 0;
+        for (; i + L <= n; i += L) {
+            for (size_t k = 0; k != L; ++k) {
+                lanesLo[k] = p[i + k] < lanesLo[k] ? p[i + k] : lanesLo[k];
+                lanesHi[k] = lanesHi[k] < p[i + k] ? p[i + k] : lanesHi[k];
+            }
+        }
+        for (size_t k = 0; i != n; ++i, ++k) {
+            lanesLo[k] = p[i] < lanesLo[k] ? p[i] : lanesLo[k];
+            lanesHi[k] = lanesHi[k] < p[i] ? p[i] : lanesHi[k];
+        }
+        for (size_t k = 0; k != L; ++k) {
+            lo[k % D] = std::min(lo[k % D], lanesLo[k]);
+            hi[k % D] = std::max(hi[k % D], lanesHi[k]);
+        }
+    }
+    else {
+        for (T const *p = data + b, *end = data + e; p != end; ++p) {
+            minMax[0] = Min(minMax[0], *p);
+            minMax[1] = Max(minMax[1], *p);
+        }
+    }
+}
+
+// The GfRange type that bounds elements of type T, for VtArrayExtent().
+template <class T> struct ExtentRange;
+template <> struct ExtentRange<float>   { using type = GfRange1f; };
+template <> struct ExtentRange<double>  { using type = GfRange1d; };
+template <> struct ExtentRange<GfVec2f> { using type = GfRange2f; };
+template <> struct ExtentRange<GfVec2d> { using type = GfRange2d; };
+template <> struct ExtentRange<GfVec3f> { using type = GfRange3f; };
+template <> struct ExtentRange<GfVec3d> { using type = GfRange3d; };
+
+// Return an array of n elements whose contents are left uninitialized, for
+// kernels that overwrite every element.  This is limited to trivially
+// copyable types, which the Gf vector and quaternion types are even though
+// some of them declare default constructors that do nothing.
+template <class T>
+VtArray<T>
+MakeUninitialized(size_t n)
+{
+    static_assert(std::is_trivially_copyable_v<T> &&
+                  std::is_trivially_destructible_v<T>);
+    VtArray<T> result;
+    result.resize(n, [](T *, T *) {});
+    return result;
+}
+
+// The kinds of 3-vectors that VtArrayTransform*() handle.
+enum class XformKind { Point, Direction, Normal };
+
+// A GfMatrix4d converted to the precision S used for the arithmetic, and
+// reduced to what the transform of the given kind needs.  For points, this is
+// the full matrix, along with whether it has a projective column that
+// requires a divide by w.  For directions it is the upper 3x3 block, and for
+// normals it is the inverse transpose of that block.
+template <XformKind Kind, class S>
+struct Xform
+{
+    explicit Xform(GfMatrix4d const &m) {
+        if constexpr (Kind == XformKind::Normal) {
+            // The inverse transpose is the cofactor matrix divided by the
+            // determinant.  If the block is singular, use the cofactors
+            // alone, which still map normals of the non-degenerate
+            // directions correctly.
+            double c[3][3];
+            for (int i = 0; i != 3; ++i) {
+                const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+                for (int j = 0; j != 3; ++j) {
+                    const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                    c[i][j] = m[i1][j1] * m[i2][j2] - m[i1][j2] * m[i2][j1];
+                }
+            }
+            const double det =
+                m[0][0] * c[0][0] + m[0][1] * c[0][1] + m[0][2] * c[0][2];
+            const double scale = det != 0.0 ? 1.0 / det : 1.0;
+            for (int i = 0; i != 3; ++i) {
+                for (int j = 0; j != 3; ++j) {
+                    // Rows of the inverse transpose are the rows of the
+                    // cofactor matrix.
+                    r[i][j] = static_cast<S>(c[i][j] * scale);
+                }
+                r[i][3] = S(0);
+            }
+            for (int j = 0; j != 4; ++j) {
+                r[3][j] = S(0);
+            }
+            projective = false;
+        }
+        else {
+            for (int i = 0; i != 4; ++i) {
+                for (int j = 0; j != 4; ++j) {
+                    r[i][j] = static_cast<S>(m[i][j]);
+                }
+            }
+            projective = Kind == XformKind::Point &&
+                (m[0][3] != 0.0 || m[1][3] != 0.0 || m[2][3] != 0.0 ||
+                 m[3][3] != 1.0);
+        }
+    }
+
+    // Transform elements [b, e) of src into dst.  Gf uses row vectors, so a
+    // point p maps to p * M.
+    template <class T>
+    void Apply(T const *src, T *dst, size_t b, size_t e) const {
+        using TS = typename T::ScalarType;
+        TS const *in = src[0].data();
+        TS *out = dst[0].data();
+        const S r00 = r[0][0], r01 = r[0][1], r02 = r[0][2];
+        const S r10 = r[1][0], r11 = r[1][1], r12 = r[1][2];
+        const S r20 = r[2][0], r21 = r[2][1], r22 = r[2][2];
+        const S t0 = Kind == XformKind::Point ? r[3][0] : S(0);
+        const S t1 = Kind == XformKind::Point ? r[3][1] : S(0);
+        const S t2 = Kind == XformKind::Point ? r[3][2] : S(0);
+        if (Kind == XformKind::Point && projective) {
+            const S w0 = r[0][3], w1 = r[1][3], w2 = r[2][3], w3 = r[3][3];
+            for (size_t i = 3 * b, end = 3 * e; i != end; i += 3) {
+                const S x = in[i], y = in[i + 1], z = in[i + 2];
+                const S w = x * w0 + y * w1 + z * w2 + w3;
+                // Match GfProject(), which leaves w == 0 results unscaled.
+                const S inv = w != S(0) ? S(1) / w : S(1);
+                out[i]     = static_cast<TS>((x*r00 + y*r10 + z*r20 + t0) * inv);
+                out[i + 1] = static_cast<TS>((x*r01 + y*r11 + z*r21 + t1) * inv);
+                out[i + 2] = static_cast<TS>((x*r02 + y*r12 + z*r22 + t2) * inv);
+            }
+        }
+        else {
+            for (size_t i = 3 * b, end = 3 * e; i != end; i += 3) {
+                const S x = in[i], y = in[i + 1], z = in[i + 2];
+                out[i]     = static_cast<TS>(x*r00 + y*r10 + z*r20 + t0);
+                out[i + 1] = static_cast<TS>(x*r01 + y*r11 + z*r21 + t1);
+                out[i + 2] = static_cast<TS>(x*r02 + y*r12 + z*r22 + t2);
+            }
+        }
+    }
+
+    S r[4][4];
+    bool projective;
+};
+
+// The precision in which to transform elements of type T.
+template <class T>
+using XformScalar = std::conditional_t<
+    std::is_same_v<T, GfVec3d>, double, float>;
+
+template <class T>
+constexpr bool IsXformable =
+    std::is_same_v<T, GfVec3f> || std::is_same_v<T, GfVec3d>;
+
+template <XformKind Kind, class T>
+VtArray<T>
+Transform(VtArray<T> const &vecs, GfMatrix4d const &matrix,
+          bool accumulateInDouble)
+{
+    static_assert(IsXformable<T>,
+                  "Transforms are only supported for GfVec3f and GfVec3d");
+    VtArray<T> result = MakeUninitialized<T>(vecs.size());
+    T const *src = vecs.cdata();
+    T *dst = result.data();
+    auto run = [&](auto const &xf) {
+        ParallelFor(vecs.size(), [&xf, src, dst](size_t b, size_t e) {
+            xf.Apply(src, dst, b, e);
+        });
+    };
+    if (accumulateInDouble) {
+        run(Xform<Kind, double>(matrix));
+    }
+    else {
+        run(Xform<Kind, XformScalar<T>>(matrix));
+    }
+    return result;
+}
+
+template <XformKind Kind, class T>
+VtArray<T>
+Transform(VtArray<T> const &vecs, VtMatrix4dArray const &matrices,
+          bool accumulateInDouble, char const *funcName)
+{
+    static_assert(IsXformable<T>,
+                  "Transforms are only supported for GfVec3f and GfVec3d");
+    if (matrices.size() != vecs.size()) {
+        TF_CODING_ERROR("%s: number of matrices (%zu) does not match number "
+                        "of elements (%zu)", funcName,
+                        matrices.size(), vecs.size());
+        return VtArray<T>();
+    }
+    VtArray<T> result = MakeUninitialized<T>(vecs.size());
+    T const *src = vecs.cdata();
+    GfMatrix4d const *mats = matrices.cdata();
+    T *dst = result.data();
+    auto run = [&](auto precision) {
+        using S = decltype(precision);
+        ParallelFor(vecs.size(), [src, mats, dst](size_t b, size_t e) {
+            for (size_t i = b; i != e; ++i) {
+                Xform<Kind, S>(mats[i]).Apply(src, dst, i, i + 1);
+            }
+        });
+    };
+    if (accumulateInDouble) {
+        run(double());
+    }
+    else {
+        run(XformScalar<T>());
+    }
+    return result;
+}
+
+// Issue a coding error and return false if two inputs to funcName that must
+// have matching sizes do not.
+inline bool
+CheckSameSize(char const *funcName, size_t size0, size_t size1)
+{
+    if (size0 != size1) {
+        TF_CODING_ERROR("%s: array sizes do not match (%zu vs %zu)",
+                        funcName, size0, size1);
+        return false;
+    }
+    return true;
+}
+
+// The precision in which to do arithmetic on elements with scalar type S.
+// Half precision elements are computed in float.
+template <class S>
+using ComputeScalar = std::conditional_t<
+    std::is_same_v<S, double>, double, float>;
+
+// A quaternion unpacked into scalars of precision C, so that the kernels
+// below do their arithmetic without round-tripping through the element type.
+template <class C>
+struct Quat
+{
+    template <class Q>
+    static Quat Load(Q const &q) {
+        auto const &im = q.GetImaginary();
+        return { C(q.GetReal()), C(im[0]), C(im[1]), C(im[2]) };
+    }
+
+    template <class Q>
+    Q Store() const {
+        using S = typename Q::ScalarType;
+        return Q(S(r), S(i), S(j), S(k));
+    }
+
+    C Dot(Quat const &o) const {
+        return r * o.r + i * o.i + j * o.j + k * o.k;
+    }
+
+    // The Hamilton product, as GfQuat's operator* computes it.
+    Quat operator*(Quat const &o) const {
+        return { r * o.r - (i * o.i + j * o.j + k * o.k),
+                 r * o.i + o.r * i + (j * o.k - k * o.j),
+                 r * o.j + o.r * j + (k * o.i - i * o.k),
+                 r * o.k + o.r * k + (i * o.j - j * o.i) };
+    }
+
+    Quat Scaled(C s) const { return { r * s, i * s, j * s, k * s }; }
+
+    void AddScaled(Quat const &o, C s) {
+        r += o.r * s; i += o.i * s; j += o.j * s; k += o.k * s;
+    }
+
+    C r, i, j, k;
+};
+
+// The minimum length GfQuat and GfDualQuat normalize without falling back to
+// the identity.
+constexpr double MinQuatLength = 1e-10;
+
+template <class C>
+Quat<C>
+NormalizeQuat(Quat<C> const &q)
+{
+    const C len = std::sqrt(q.Dot(q));
+    if (len < C(MinQuatLength)) {
+        return { C(1), C(0), C(0), C(0) };
+    }
+    return q.Scaled(C(1) / len);
+}
+
+// Spherical linear interpolation along the shorter arc, as GfSlerp() does.
+template <class C>
+Quat<C>
+SlerpQuat(C alpha, Quat<C> const &q0, Quat<C> const &q1)
+{
+    C cosTheta = q0.Dot(q1);
+    const bool flip1 = cosTheta < C(0);
+    if (flip1) {
+        cosTheta = -cosTheta;
+    }
+    C scale0, scale1;
+    if (C(1) - cosTheta > C(0.00001)) {
+        const C theta = std::acos(cosTheta);
+        const C invSinTheta = C(1) / std::sin(theta);
+        scale0 = std::sin((C(1) - alpha) * theta) * invSinTheta;
+        scale1 = std::sin(alpha * theta) * invSinTheta;
+    }
+    else {
+        scale0 = C(1) - alpha;
+        scale1 = alpha;
+    }
+    Quat<C> result = q0.Scaled(scale0);
+    result.AddScaled(q1, flip1 ? -scale1 : scale1);
+    return result;
+}
+
+// Normalize a dual quaternion the way GfDualQuat::GetNormalized() does:
+// scale both parts by the length of the real part, then make the dual part
+// orthogonal to the real part.
+template <class C>
+void
+NormalizeDualQuat(Quat<C> &real, Quat<C> &dual)
+{
+    const C len = std::sqrt(real.Dot(real));
+    if (len < C(MinQuatLength)) {
+        real = { C(1), C(0), C(0), C(0) };
+        dual = { C(0), C(0), C(0), C(0) };
+        return;
+    }
+    const C inv = C(1) / len;
+    real = real.Scaled(inv);
+    dual = dual.Scaled(inv);
+    dual.AddScaled(real, -real.Dot(dual));
+}
+
+template <class Q>
+constexpr bool IsQuat =
+    std::is_same_v<Q, GfQuath> || std::is_same_v<Q, GfQuatf> ||
+    std::is_same_v<Q, GfQuatd>;
+
+template <class DQ>
+constexpr bool IsDualQuat =
+    std::is_same_v<DQ, GfDualQuath> || std::is_same_v<DQ, GfDualQuatf> ||
+    std::is_same_v<DQ, GfDualQuatd>;
+
+// Return a VtBoolArray of n elements, with element i set to pred(i).
+template <class Pred>
+VtBoolArray
+MakeMask(size_t n, Pred const &pred)
+{
+    VtBoolArray result = MakeUninitialized<bool>(n);
+    bool *dst = result.data();
+    ParallelFor(n, [&pred, dst](size_t b, size_t e) {
+        for (size_t i = b; i != e; ++i) {
+            dst[i] = pred(i);
+        }
+    });
+    return result;
+}
+
+// How many elements ahead gathers and scatters prefetch.
+constexpr size_t PrefetchDistance = 16;
+
+inline void
+PrefetchForRead(void const *p)
+{
+#if defined(ARCH_COMPILER_GCC) || defined(ARCH_COMPILER_CLANG)
+    __builtin_prefetch(p, /*rw=*/0);
+#endif
+}
+
+inline void
+PrefetchForWrite(void const *p)
+{
+#if defined(ARCH_COMPILER_GCC) || defined(ARCH_COMPILER_CLANG)
+    __builtin_prefetch(p, /*rw=*/1);
+#endif
+}
+
+// Return true if every index is in [0, size).  Otherwise issue a coding
+// error naming funcName and return false.  The indices are checked all at
+// once with a parallel reduction, so the kernels that use them need not check
+// each one.
+template <class IndexArray>
+bool
+CheckIndices(char const *funcName, IndexArray const &indices, size_t size)
+{
+    typename IndexArray::value_type minIndex, maxIndex;
+    if (!VtArrayMinMax(indices, &minIndex, &maxIndex)) {
+        return true;
+    }
+    if (minIndex < 0 || static_cast<size_t>(maxIndex) >= size) {
+        TF_CODING_ERROR("%s: indices range from %lld to %lld, outside "
+                        "[0, %zu)", funcName,
+                        static_cast<long long>(minIndex),
+                        static_cast<long long>(maxIndex), size);
+        return false;
+    }
+    return true;
+}
+
+// Return true if no index in indices appears more than once.  All indices
+// must be in [0, size).  Mark the indices seen in a bitset of size bits, or
+// if that would be larger than the indices themselves, sort a copy of them.
+inline bool
+AreIndicesUnique(VtIntArray const &indices, size_t size)
+{
+    if (indices.size() < (size + 63) / 64) {
+        std::vector<int> sorted(indices.cbegin(), indices.cend());
+        std::sort(sorted.begin(), sorted.end());
+        return std::adjacent_find(sorted.begin(), sorted.end()) ==
+            sorted.end();
+    }
+    std::vector<std::atomic<uint64_t>> seen((size + 63) / 64);
+    for (auto &word: seen) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<bool> unique { true };
+    int const *idx = indices.cdata();
+    ParallelFor(indices.size(), [&](size_t b, size_t e) {
+        for (size_t i = b; i != e; ++i) {
+            const uint64_t bit = uint64_t(1) << (idx[i] % 64);
+            if (seen[idx[i] / 64].fetch_or(
+                    bit, std::memory_order_relaxed) & bit) {
+                unique.store(false, std::memory_order_relaxed);
+                return;
+            }
+        }
+    });
+    return unique;
+}
+
+// Whether elements of type From can be converted to To by converting their
+// flat scalar representations one by one.
+template <class To, class From>
+constexpr bool IsFlatConvertible = [] {
+    if constexpr (IsFlat<To> && IsFlat<From>) {
+        return FlatTraits<To>::Dim == FlatTraits<From>::Dim;
+    }
+    else {
+        return false;
+    }
+}();
+
+} // Vt_FunctionsDetail
+
+/// Return the sum of the elements in \p array, or VtZero<T>() if \p array is
+/// empty.  Gf vectors are summed component-wise.
+///
+/// Large arrays are summed in parallel.  Since floating point addition is not
+/// associative, the result may then differ in the last bits from run to run.
+/// Pass \p deterministic = true to partition the work and combine the
+/// partial sums in an order that depends only on the array's size, which
+/// makes the result reproducible.
+template <class T>
+T
+VtArraySum(VtArray<T> const &array, bool deterministic = false)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    T const *data = array.cdata();
+    return Detail::ParallelReduce(
+        array.size(), VtZero<T>(),
+        [data](size_t b, size_t e, T const &acc) {
+            return Detail::SumChunk(data, b, e, acc);
+        },
+        [](T const &l, T const &r) { return T(l + r); },
+        deterministic);
+}
+
+/// Return the sum of the products of corresponding elements of \p a and \p
+/// b.  For Gf vectors, this is the sum of the dot products of corresponding
+/// vectors.  This is supported for arithmetic element types other than bool
+/// and for Gf vectors of them.  If \p a and \p b have different sizes, issue
+/// a coding error and return zero.
+///
+/// Large arrays are processed in parallel.  As with VtArraySum(), pass \p
+/// deterministic = true for floating point results that are reproducible from
+/// run to run.
+template <class T>
+typename Vt_FunctionsDetail::FlatTraits<T>::Scalar
+VtArrayDot(VtArray<T> const &a, VtArray<T> const &b,
+           bool deterministic = false)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    static_assert(Detail::IsFlat<T>,
+                  "VtArrayDot requires arithmetic elements or Gf vectors");
+    using S = typename Detail::FlatTraits<T>::Scalar;
+    if (!Detail::CheckSameSize("VtArrayDot", a.size(), b.size())) {
+        return S(0);
+    }
+    T const *pa = a.cdata();
+    T const *pb = b.cdata();
+    return Detail::ParallelReduce(
+        a.size(), S(0),
+        [pa, pb](size_t first, size_t last, S acc) {
+            return Detail::DotChunk(pa, pb, first, last, acc);
+        },
+        [](S l, S r) { return S(l + r); },
+        deterministic);
+}
+
+/// Compute the minimum and maximum elements of \p array, storing them in \p
+/// min and \p max.  Gf vectors are compared component-wise, so for them the
+/// results are the lower and upper corners of the elements' bounding box.
+/// Return false and leave \p min and \p max unmodified if \p array is empty.
+/// Large arrays are processed in parallel.
+template <class T>
+bool
+VtArrayMinMax(VtArray<T> const &array,
+              typename VtArray<T>::value_type *min,
+              typename VtArray<T>::value_type *max)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    if (array.empty()) {
+        return false;
+    }
+    struct _MinMax { T v[2]; };
+    T const *data = array.cdata();
+    const _MinMax result = Detail::ParallelReduce(
+        array.size(), _MinMax { { data[0], data[0] } },
+        [data](size_t b, size_t e, _MinMax acc) {
+            Detail::MinMaxChunk(data, b, e, acc.v);
+            return acc;
+        },
+        [](_MinMax const &l, _MinMax const &r) {
+            return _MinMax { { Detail::Min(l.v[0], r.v[0]),
+                               Detail::Max(l.v[1], r.v[1]) } };
+        },
+        /*deterministic=*/false);
+    if (min) {
+        *min = result.v[0];
+    }
+    if (max) {
+        *max = result.v[1];
+    }
+    return true;
+}
+
+/// Return the axis-aligned bounding box of the points in \p array, as a
+/// GfRange of matching dimension and precision.  Return an empty range if \p
+/// array is empty.  This is supported for float, double, and the 2 and 3
+/// dimensional float and double Gf vectors.  Large arrays are processed in
+/// parallel.
+template <class T>
+typename Vt_FunctionsDetail::ExtentRange<T>::type
+VtArrayExtent(VtArray<T> const &array)
+{
+    using RangeType = typename Vt_FunctionsDetail::ExtentRange<T>::type;
+    T min, max;
+    if (!VtArrayMinMax(array, &min, &max)) {
+        return RangeType();
+    }
+    return RangeType(min, max);
+}
+
+/// \name Transforms
+/// Transform arrays of 3-vectors by a single matrix, or by a matrix per
+/// element for skinning-style workloads.  These are supported for
+/// VtVec3fArray and VtVec3dArray and return a new array of the same type.
+///
+/// The per-element overloads require \p matrices to have the same size as
+/// the input array.  If they do not, they issue a coding error and return an
+/// empty array.
+///
+/// By default the arithmetic is done in double precision, which matches what
+/// GfMatrix4d produces for GfVec3f.  Pass \p accumulateInDouble = false to
+/// transform VtVec3fArray in single precision instead, which is faster but
+/// rounds the matrix to float.  VtVec3dArray is always transformed in double
+/// precision.  Large arrays are processed in parallel.
+/// @{
+
+/// Transform each point in \p points by \p matrix, as
+/// GfMatrix4d::Transform() does, including the divide by w for projective
+/// matrices.
+template <class T>
+VtArray<T>
+VtArrayTransformPoints(VtArray<T> const &points, GfMatrix4d const &matrix,
+                       bool accumulateInDouble = true)
+{
+    TRACE_FUNCTION();
+    return Vt_FunctionsDetail::Transform<
+        Vt_FunctionsDetail::XformKind::Point>(
+            points, matrix, accumulateInDouble);
+}
+
+/// Transform each point in \p points by the corresponding matrix in \p
+/// matrices.
+template <class T>
+VtArray<T>
+VtArrayTransformPoints(VtArray<T> const &points,
+                       VtMatrix4dArray const &matrices,
+                       bool accumulateInDouble = true)
+{
+    TRACE_FUNCTION();
+    return Vt_FunctionsDetail::Transform<
+        Vt_FunctionsDetail::XformKind::Point>(
+            points, matrices, accumulateInDouble, "VtArrayTransformPoints");
+}
+
+/// Transform each direction in \p dirs by the upper 3x3 block of \p matrix,
+/// as GfMatrix4d::TransformDir() does.
+template <class T>
+VtArray<T>
+VtArrayTransformDirections(VtArray<T> const &dirs, GfMatrix4d const &matrix,
+                           bool accumulateInDouble = true)
+{
+    TRACE_FUNCTION();
+    return Vt_FunctionsDetail::Transform<
+        Vt_FunctionsDetail::XformKind::Direction>(
+            dirs, matrix, accumulateInDouble);
+}
+
+/// Transform each direction in \p dirs by the upper 3x3 block of the
+/// corresponding matrix in \p matrices.
+template <class T>
+VtArray<T>
+VtArrayTransformDirections(VtArray<T> const &dirs,
+                           VtMatrix4dArray const &matrices,
+                           bool accumulateInDouble = true)
+{
+    TRACE_FUNCTION();
+    return Vt_FunctionsDetail::Transform<
+        Vt_FunctionsDetail::XformKind::Direction>(
+            dirs, matrices, accumulateInDouble,
+            "VtArrayTransformDirections");
+}
+
+/// Transform each normal in \p normals by the inverse transpose of the upper
+/// 3x3 block of \p matrix, so that it stays perpendicular to transformed
+/// surfaces.  The results are not renormalized.
+template <class T>
+VtArray<T>
+VtArrayTransformNormals(VtArray<T> const &normals, GfMatrix4d const &matrix,
+                        bool accumulateInDouble = true)
+{
+    TRACE_FUNCTION();
+    return Vt_FunctionsDetail::Transform<
+        Vt_FunctionsDetail::XformKind::Normal>(
+            normals, matrix, accumulateInDouble);
+}
+
+/// Transform each normal in \p normals by the inverse transpose of the upper
+/// 3x3 block of the corresponding matrix in \p matrices.  The results are not
+/// renormalized.
+template <class T>
+VtArray<T>
+VtArrayTransformNormals(VtArray<T> const &normals,
+                        VtMatrix4dArray const &matrices,
+                        bool accumulateInDouble = true)
+{
+    TRACE_FUNCTION();
+    return Vt_FunctionsDetail::Transform<
+        Vt_FunctionsDetail::XformKind::Normal>(
+            normals, matrices, accumulateInDouble,
+            "VtArrayTransformNormals");
+}
+
+/// @}
+
+/// \name Quaternions
+/// Batch operations on arrays of GfQuath, GfQuatf and GfQuatd, and on arrays
+/// of the corresponding dual quaternions.  Half precision elements are
+/// computed in float.  Functions that take two arrays require them to have
+/// the same size.  If they do not, they issue a coding error and return an
+/// empty array.  Large arrays are processed in parallel.
+/// @{
+
+/// Return the quaternions in \p quats scaled to unit length.  Quaternions
+/// too short to normalize become the identity, as with
+/// GfQuat::GetNormalized().
+template <class Q>
+VtArray<Q>
+VtArrayQuatNormalize(VtArray<Q> const &quats)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    static_assert(Detail::IsQuat<Q>);
+    using C = Detail::ComputeScalar<typename Q::ScalarType>;
+    VtArray<Q> result = Detail::MakeUninitialized<Q>(quats.size());
+    Q const *src = quats.cdata();
+    Q *dst = result.data();
+    Detail::ParallelFor(quats.size(), [src, dst](size_t b, size_t e) {
+        for (size_t i = b; i != e; ++i) {
+            dst[i] = Detail::NormalizeQuat(
+                Detail::Quat<C>::Load(src[i])).template Store<Q>();
+        }
+    });
+    return result;
+}
+
+/// Return the element-wise products \p lhs[i] * \p rhs[i].
+template <class Q>
+VtArray<Q>
+VtArrayQuatMultiply(VtArray<Q> const &lhs, VtArray<Q> const &rhs)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    static_assert(Detail::IsQuat<Q>);
+    using C = Detail::ComputeScalar<typename Q::ScalarType>;
+    if (!Detail::CheckSameSize(
+            "VtArrayQuatMultiply", lhs.size(), rhs.size())) {
+        return VtArray<Q>();
+    }
+    VtArray<Q> result = Detail::MakeUninitialized<Q>(lhs.size());
+    Q const *l = lhs.cdata();
+    Q const *r = rhs.cdata();
+    Q *dst = result.data();
+    Detail::ParallelFor(lhs.size(), [l, r, dst](size_t b, size_t e) {
+        for (size_t i = b; i != e; ++i) {
+            dst[i] = (Detail::Quat<C>::Load(l[i]) *
+                      Detail::Quat<C>::Load(r[i])).template Store<Q>();
+        }
+    });
+    return result;
+}
+
+/// Return the element-wise spherical linear interpolations between \p q0
+/// and \p q1 at \p alpha, as computed by GfSlerp().
+template <class Q>
+VtArray<Q>
+VtArrayQuatSlerp(double alpha, VtArray<Q> const &q0, VtArray<Q> const &q1)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    static_assert(Detail::IsQuat<Q>);
+    using C = Detail::ComputeScalar<typename Q::ScalarType>;
+    if (!Detail::CheckSameSize("VtArrayQuatSlerp", q0.size(), q1.size())) {
+        return VtArray<Q>();
+    }
+    VtArray<Q> result = Detail::MakeUninitialized<Q>(q0.size());
+    Q const *a = q0.cdata();
+    Q const *b = q1.cdata();
+    Q *dst = result.data();
+    const C t = static_cast<C>(alpha);
+    Detail::ParallelFor(q0.size(), [t, a, b, dst](size_t first, size_t last) {
+        for (size_t i = first; i != last; ++i) {
+            dst[i] = Detail::SlerpQuat(
+                t, Detail::Quat<C>::Load(a[i]),
+                Detail::Quat<C>::Load(b[i])).template Store<Q>();
+        }
+    });
+    return result;
+}
+
+/// Return \p vecs[i] rotated by \p quats[i], as GfQuat::Transform() does.
+/// The quaternions need not have unit length.  Vectors paired with a zero
+/// quaternion are returned unchanged.  This is supported for VtVec3fArray
+/// and VtVec3dArray.
+template <class Q, class V>
+VtArray<V>
+VtArrayQuatRotate(VtArray<Q> const &quats, VtArray<V> const &vecs)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    static_assert(Detail::IsQuat<Q>);
+    static_assert(Detail::IsXformable<V>,
+                  "Rotations are only supported for GfVec3f and GfVec3d");
+    using C = std::conditional_t<
+        std::is_same_v<V, GfVec3d>,
+        double, Detail::ComputeScalar<typename Q::ScalarType>>;
+    using VS = typename V::ScalarType;
+    if (!Detail::CheckSameSize(
+            "VtArrayQuatRotate", quats.size(), vecs.size())) {
+        return VtArray<V>();
+    }
+    VtArray<V> result = Detail::MakeUninitialized<V>(vecs.size());
+    Q const *q = quats.cdata();
+    VS const *in = vecs.cdata()->data();
+    VS *out = result.data()->data();
+    Detail::ParallelFor(vecs.size(), [q, in, out](size_t b, size_t e) {
+        for (size_t n = b; n != e; ++n) {
+            const Detail::Quat<C> u = Detail::Quat<C>::Load(q[n]);
+            const C x = in[3*n], y = in[3*n + 1], z = in[3*n + 2];
+            const C norm2 = u.Dot(u);
+            if (norm2 == C(0)) {
+                out[3*n] = in[3*n];
+                out[3*n + 1] = in[3*n + 1];
+                out[3*n + 2] = in[3*n + 2];
+                continue;
+            }
+            // q v q^-1 = ((r^2 - |u|^2) v + 2 (u.v) u + 2 r (u x v)) / |q|^2
+            const C inv = C(1) / norm2;
+            const C s = (u.r * u.r - (u.i * u.i + u.j * u.j + u.k * u.k));
+            const C d = C(2) * (u.i * x + u.j * y + u.k * z);
+            const C r2 = C(2) * u.r;
+            out[3*n]     = static_cast<VS>(
+                (s * x + d * u.i + r2 * (u.j * z - u.k * y)) * inv);
+            out[3*n + 1] = static_cast<VS>(
+                (s * y + d * u.j + r2 * (u.k * x - u.i * z)) * inv);
+            out[3*n + 2] = static_cast<VS>(
+                (s * z + d * u.k + r2 * (u.i * y - u.j * x)) * inv);
+        }
+    });
+    return result;
+}
+
+/// Blend dual quaternions for dual quaternion skinning.  Each element of
+/// the result is the normalized, weighted sum of \p numInfluencesPerElement
+/// entries of \p dualQuats, selected by consecutive entries of \p indices
+/// and weighted by the corresponding entries of \p weights.  Influences whose
+/// real part points away from the element's first influence are negated
+/// before summing, so that blends take the shorter path.
+///
+/// \p indices and \p weights must have the same size, which must be a
+/// multiple of \p numInfluencesPerElement.  Otherwise, issue a coding error
+/// and return an empty array.  Influences with out-of-range indices are
+/// skipped and reported with a single coding error.
+template <class DQ>
+VtArray<DQ>
+VtArrayDualQuatBlend(VtArray<DQ> const &dualQuats,
+                     VtIntArray const &indices,
+                     VtFloatArray const &weights,
+                     int numInfluencesPerElement)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    static_assert(Detail::IsDualQuat<DQ>);
+    using Q = typename DQ::QuatType;
+    using C = Detail::ComputeScalar<typename DQ::ScalarType>;
+    if (!Detail::CheckSameSize(
+            "VtArrayDualQuatBlend", indices.size(), weights.size())) {
+        return VtArray<DQ>();
+    }
+    if (numInfluencesPerElement <= 0 ||
+        indices.size() % numInfluencesPerElement != 0) {
+        TF_CODING_ERROR("VtArrayDualQuatBlend: invalid number of influences "
+                        "per element (%d) for %zu influences",
+                        numInfluencesPerElement, indices.size());
+        return VtArray<DQ>();
+    }
+
+    const size_t numInfluences = numInfluencesPerElement;
+    const size_t numElements = indices.size() / numInfluences;
+    const size_t numDualQuats = dualQuats.size();
+    VtArray<DQ> result = Detail::MakeUninitialized<DQ>(numElements);
+    DQ const *dqs = dualQuats.cdata();
+    int const *idx = indices.cdata();
+    float const *wts = weights.cdata();
+    DQ *dst = result.data();
+    std::atomic<bool> badIndex { false };
+    Detail::ParallelFor(numElements, [&](size_t b, size_t e) {
+        for (size_t n = b; n != e; ++n) {
+            Detail::Quat<C> real { 0, 0, 0, 0 }, dual { 0, 0, 0, 0 };
+            Detail::Quat<C> pivot { 0, 0, 0, 0 };
+            bool havePivot = false;
+            for (size_t k = n * numInfluences,
+                     end = k + numInfluences; k != end; ++k) {
+                const int i = idx[k];
+                if (i < 0 || static_cast<size_t>(i) >= numDualQuats) {
+                    badIndex.store(true, std::memory_order_relaxed);
+                    continue;
+                }
+                const Detail::Quat<C> r =
+                    Detail::Quat<C>::Load(dqs[i].GetReal());
+                if (!havePivot) {
+                    pivot = r;
+                    havePivot = true;
+                }
+                const C w = pivot.Dot(r) < C(0) ? -C(wts[k]) : C(wts[k]);
+                real.AddScaled(r, w);
+                dual.AddScaled(Detail::Quat<C>::Load(dqs[i].GetDual()), w);
+            }
+            Detail::NormalizeDualQuat(real, dual);
+            dst[n] = DQ(real.template Store<Q>(), dual.template Store<Q>());
+        }
+    });
+    if (badIndex) {
+        TF_CODING_ERROR("VtArrayDualQuatBlend: indices out of range for %zu "
+                        "dual quaternions", numDualQuats);
+    }
+    return result;
+}
+
+/// @}
+
+/// \name Comparisons and masks
+/// Element-wise comparisons produce a VtBoolArray mask with one element per
+/// compared element.  Each comparison compares two arrays of the same size,
+/// or every element of an array to a single value.  Comparing arrays of
+/// different sizes issues a coding error and returns an empty mask.  Masks
+/// can be passed to VtArraySelect() and VtArrayCompress().  Large arrays are
+/// processed in parallel.
+/// @{
+
+#define VTFUNCTION_BOOL(funcName, op)                                       \
+template <class T>                                                          \
+VtBoolArray                                                                 \
+funcName(VtArray<T> const &a, VtArray<T> const &b)                          \
+{                                                                           \
+    if (!Vt_FunctionsDetail::CheckSameSize(#funcName, a.size(), b.size())) {\
+        return VtBoolArray();                                               \
+    }                                                                       \
+    T const *l = a.cdata(), *r = b.cdata();                                 \
+    return Vt_FunctionsDetail::MakeMask(a.size(), [l, r](size_t i) {        \
+        return bool(l[i] op r[i]);                                          \
+    });                                                                     \
+}                                                                           \
+template <class T>                                                          \
+VtBoolArray                                                                 \
+funcName(VtArray<T> const &a, typename VtArray<T>::value_type const &b)     \
+{                                                                           \
+    T const *l = a.cdata();                                                 \
+    return Vt_FunctionsDetail::MakeMask(a.size(), [l, &b](size_t i) {       \
+        return bool(l[i] op b);                                             \
+    });                                                                     \
+}                                                                           \
+template <class T>                                                          \
+VtBoolArray                                                                 \
+funcName(typename VtArray<T>::value_type const &a, VtArray<T> const &b)     \
+{                                                                           \
+    T const *r = b.cdata();                                                 \
+    return Vt_FunctionsDetail::MakeMask(b.size(), [&a, r](size_t i) {       \
+        return bool(a op r[i]);                                             \
+    });                                                                     \
+}
+
+VTFUNCTION_BOOL(VtEqual, ==)
+VTFUNCTION_BOOL(VtNotEqual, !=)
+VTFUNCTION_BOOL(VtGreater, >)
+VTFUNCTION_BOOL(VtLess, <)
+VTFUNCTION_BOOL(VtGreaterOrEqual, >=)
+VTFUNCTION_BOOL(VtLessOrEqual, <=)
+
+#undef VTFUNCTION_BOOL
+
+/// Return an array whose elements are taken from \p a where \p mask is true
+/// and from \p b where it is false.  All three arrays must have the same
+/// size.  Otherwise, issue a coding error and return an empty array.
+template <class T>
+VtArray<T>
+VtArraySelect(VtBoolArray const &mask,
+              VtArray<T> const &a, VtArray<T> const &b)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    if (!Detail::CheckSameSize("VtArraySelect", mask.size(), a.size()) ||
+        !Detail::CheckSameSize("VtArraySelect", mask.size(), b.size())) {
+        return VtArray<T>();
+    }
+    bool const *m = mask.cdata();
+    T const *pa = a.cdata();
+    T const *pb = b.cdata();
+    VtArray<T> result;
+    result.resize(mask.size(), [&](T *out, T *) {
+        Detail::ParallelFor(mask.size(), [=](size_t first, size_t last) {
+            for (size_t i = first; i != last; ++i) {
+                new (out + i) T(m[i] ? pa[i] : pb[i]);
+            }
+        });
+    });
+    return result;
+}
+
+/// Return the elements of \p array where \p mask is true, in order.  \p mask
+/// must have the same size as \p array.  Otherwise, issue a coding error and
+/// return an empty array.
+template <class T>
+VtArray<T>
+VtArrayCompress(VtArray<T> const &array, VtBoolArray const &mask)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    if (!Detail::CheckSameSize("VtArrayCompress", array.size(), mask.size())) {
+        return VtArray<T>();
+    }
+
+    // Count the selected elements in each block, then turn the counts into
+    // each block's offset in the result so that blocks can be copied
+    // independently.
+    const size_t n = array.size();
+    bool const *m = mask.cdata();
+    T const *src = array.cdata();
+    std::vector<size_t> offsets(Detail::NumBlocks(n) + 1, 0);
+    Detail::ParallelForBlocks(n, [&](size_t block, size_t b, size_t e) {
+        size_t count = 0;
+        for (size_t i = b; i != e; ++i) {
+            count += m[i];
+        }
+        offsets[block + 1] = count;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    if (offsets.back() == n) {
+        // Everything is selected, so share the source's data.
+        return array;
+    }
+    VtArray<T> result;
+    result.resize(offsets.back(), [&](T *out, T *) {
+        Detail::ParallelForBlocks(n, [&](size_t block, size_t b, size_t e) {
+            T *dst = out + offsets[block];
+            for (size_t i = b; i != e; ++i) {
+                if (m[i]) {
+                    new (dst++) T(src[i]);
+                }
+            }
+        });
+    });
+    return result;
+}
+
+/// @}
+
+/// \name Indexing
+/// Functions for converting between indexed data, such as indexed primvars,
+/// and dense arrays.  Indices are validated up front, all at once.  Invalid
+/// indices issue a coding error, as described for each function.  Large
+/// arrays are processed in parallel.
+/// @{
+
+/// Return the array whose i'th element is \p values[\p indices[i]], which
+/// has the size of \p indices.  If any index is out of range for \p values,
+/// issue a coding error and return an empty array.
+template <class T>
+VtArray<T>
+VtArrayGather(VtArray<T> const &values, VtIntArray const &indices)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    if (!Detail::CheckIndices("VtArrayGather", indices, values.size())) {
+        return VtArray<T>();
+    }
+    const size_t n = indices.size();
+    T const *src = values.cdata();
+    int const *idx = indices.cdata();
+    VtArray<T> result;
+    result.resize(n, [&](T *out, T *) {
+        Detail::ParallelFor(n, [=](size_t b, size_t e) {
+            const size_t prefetchEnd =
+                e > Detail::PrefetchDistance ? e - Detail::PrefetchDistance : 0;
+            size_t i = b;
+            for (; i < prefetchEnd; ++i) {
+                Detail::PrefetchForRead(
+                    src + idx[i + Detail::PrefetchDistance]);
+                new (out + i) T(src[idx[i]]);
+            }
+            for (; i != e; ++i) {
+                new (out + i) T(src[idx[i]]);
+            }
+        });
+    });
+    return result;
+}
+
+/// Write each element \p values[i] to \p dest[\p indices[i]], and return the
+/// result.  Pass \p dest as an rvalue to update it in place without copying.
+/// When an index occurs more than once, the value from its last occurrence
+/// is written, as if the elements were written in order.  If \p values and
+/// \p indices have different sizes, or any index is out of range for \p
+/// dest, issue a coding error and return \p dest unmodified.
+template <class T>
+VtArray<T>
+VtArrayScatter(VtArray<T> const &values, VtIntArray const &indices,
+               VtArray<T> dest)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    if (!Detail::CheckSameSize(
+            "VtArrayScatter", values.size(), indices.size()) ||
+        !Detail::CheckIndices("VtArrayScatter", indices, dest.size())) {
+        return dest;
+    }
+    const size_t n = indices.size();
+    T const *src = values.cdata();
+    int const *idx = indices.cdata();
+    T *out = dest.data();
+    // Only parallel writes need unique indices, since repeated ones would
+    // race.  Otherwise write in order, without paying to check.
+    if (n < 2 * Detail::GrainSize ||
+        !Detail::AreIndicesUnique(indices, dest.size())) {
+        for (size_t i = 0; i != n; ++i) {
+            out[idx[i]] = src[i];
+        }
+        return dest;
+    }
+    Detail::ParallelFor(n, [=](size_t b, size_t e) {
+        const size_t prefetchEnd =
+            e > Detail::PrefetchDistance ? e - Detail::PrefetchDistance : 0;
+        size_t i = b;
+        for (; i < prefetchEnd; ++i) {
+            Detail::PrefetchForWrite(out + idx[i + Detail::PrefetchDistance]);
+            out[idx[i]] = src[i];
+        }
+        for (; i != e; ++i) {
+            out[idx[i]] = src[i];
+        }
+    });
+    return dest;
+}
+
+/// Convert the dense array \p array to indexed form: store its distinct
+/// elements in \p values, in order of first occurrence, and store in \p
+/// indices the index into \p values of each element of \p array, so that
+/// VtArrayGather(*values, *indices) reproduces \p array.  Either output may
+/// be null if it is not needed.
+template <class T>
+void
+VtArrayMakeIndexed(VtArray<T> const &array,
+                   VtArray<T> *values, VtIntArray *indices)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    std::unordered_map<T, int, TfHash> valueToIndex;
+    VtArray<T> distinct;
+    VtIntArray resultIndices =
+        Detail::MakeUninitialized<int>(indices ? array.size() : 0);
+    int *outIndex = indices ? resultIndices.data() : nullptr;
+    for (T const &elem: array) {
+        const auto iresult = valueToIndex.emplace(
+            elem, static_cast<int>(distinct.size()));
+        if (iresult.second) {
+            distinct.push_back(elem);
+        }
+        if (outIndex) {
+            *outIndex++ = iresult.first->second;
+        }
+    }
+    if (values) {
+        *values = std::move(distinct);
+    }
+    if (indices) {
+        *indices = std::move(resultIndices);
+    }
+}
+
+/// @}
+
+/// \name Conversions
+/// @{
+
+/// Return \p array with each element converted by \p convert, which is
+/// invoked as \p convert(element) and must return a value convertible to
+/// \p To.  The result is allocated without default-constructing its
+/// elements, and large arrays are converted in parallel.
+template <class To, class From, class ConvertFn>
+VtArray<To>
+VtArrayConvert(VtArray<From> const &array, ConvertFn const &convert)
+{
+    TRACE_FUNCTION();
+
+    namespace Detail = Vt_FunctionsDetail;
+    const size_t n = array.size();
+    From const *src = array.cdata();
+    VtArray<To> result;
+    result.resize(n, [&](To *out, To *) {
+        Detail::ParallelFor(n, [&convert, src, out](size_t b, size_t e) {
+            for (size_t i = b; i != e; ++i) {
+                new (out + i) To(convert(src[i]));
+            }
+        });
+    });
+    return result;
+}
+
+/// Return \p array with each element converted to \p To by explicit
+/// construction, To(element).  Arithmetic elements and Gf vectors of them
+/// are converted with flat, vectorizable loops over their scalars.  The
+/// result is allocated without default-constructing its elements, and large
+/// arrays are converted in parallel.
+template <class To, class From>
+VtArray<To>
+VtArrayConvert(VtArray<From> const &array)
+{
+    namespace Detail = Vt_FunctionsDetail;
+    if constexpr (Detail::IsFlatConvertible<To, From>) {
+        TRACE_FUNCTION();
+
+        using ToS = typename Detail::FlatTraits<To>::Scalar;
+        constexpr size_t D = Detail::FlatTraits<To>::Dim;
+        VtArray<To> result = Detail::MakeUninitialized<To>(array.size());
+        auto const *src = Detail::AsScalars(array.cdata());
+        ToS *dst = Detail::AsScalars(result.data());
+        Detail::ParallelFor(array.size(), [src, dst](size_t b, size_t e) {
+            for (size_t i = b * D, end = e * D; i != end; ++i) {
+                dst[i] = static_cast<ToS>(src[i]);
+            }
+        });
+        return result;
+    }
+    else {
+        return VtArrayConvert<To>(array, [](From const &from) {
+            return To(from);
+        });
+    }
+}
+
+/// @}
+
+VT_NAMESPACE_CLOSE_SCOPE
+
+#endif // PXR_VT_FUNCTIONS_H
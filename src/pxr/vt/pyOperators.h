@@ -19,7 +19,7 @@ struct _ArrayPyOpHelp {
     static T __add__(T l, T r) { return l + r; }
     static T __sub__(T l, T r) { return l - r; }
     static T __mul__(T l, T r) { return l * r; }
-    static T __div__(T l, T r) { return l / r; }
+    static T __truediv__(T l, T r) { return l / r; }
     static T __mod__(T l, T r) { return l % r; }
 };
 
@@ -30,7 +30,7 @@ struct _ArrayPyOpHelp<bool> {
     static bool __add__(bool l, bool r) { return l | r; }
     static bool __sub__(bool l, bool r) { return l ^ r; }
     static bool __mul__(bool l, bool r) { return l & r; }
-    static bool __div__(bool l, bool r) { return l; }
+    static bool __truediv__(bool l, bool r) { return l; }
     static bool __mod__(bool l, bool r) { return false; }
 };
 
@@ -92,11 +92,36 @@ struct _ArrayPyOpHelp<bool> {
     VTOPERATOR_WRAP_PYTYPE_R(lmethod,rmethod,tuple)         \
     VTOPERATOR_WRAP_PYTYPE_R(lmethod,rmethod,list)                
 
+// array OP array, array OP scalar and scalar OP array, computed by
+// _AllowThreadsIfLarge() so that the element-wise work on large arrays runs
+// without holding the GIL.  The lambdas capture copies of the operands.
+#define VTOPERATOR_WRAP_ALLOW_THREADS(op,name)                              \
+    template <typename T> static                                            \
+    VtArray<T> name##_array(VtArray<T> const &l, VtArray<T> const &r) {     \
+        return _AllowThreadsIfLarge(std::max(l.size(), r.size()),           \
+            [l, r]() { return VtArray<T>(l op r); });                       \
+    }                                                                       \
+    template <typename T, typename S> static                                \
+    VtArray<T> name##_scalar(VtArray<T> const &l, S const &r) {             \
+        return _AllowThreadsIfLarge(l.size(),                               \
+            [l, r]() { return VtArray<T>(l op r); });                       \
+    }                                                                       \
+    template <typename T, typename S> static                                \
+    VtArray<T> name##_rscalar(VtArray<T> const &r, S const &l) {            \
+        return _AllowThreadsIfLarge(r.size(),                               \
+            [l, r]() { return VtArray<T>(l op r); });                       \
+    }
+
+// to be used to declare the wrapping of the above with def() on the class,
+// as the python special methods pylmethod and pyrmethod, with scalars of
+// type S
+#define VTOPERATOR_WRAPDECLARE_ALLOW_THREADS(name,pylmethod,pyrmethod,S)    \
+    .def(#pylmethod,name##_array<Type>)                                     \
+    .def(#pylmethod,name##_scalar<Type,S>)                                  \
+    .def(#pyrmethod,name##_rscalar<Type,S>)
+
 // to be used to actually declare the wrapping with def() on the class
 #define VTOPERATOR_WRAPDECLARE_BASE(op,method,rettype)      \
-    .def(self op self)                                      \
-    .def(self op Type())                                    \
-    .def(Type() op self)                                    \
     .def(#method,method##tuple<rettype>)                    \
     .def(#method,method##list<rettype>)                      
 
@@ -105,6 +130,25 @@ struct _ArrayPyOpHelp<bool> {
     .def(#rmethod,rmethod##tuple<Type>)                     \
     .def(#rmethod,rmethod##list<Type>)                
 
+// base macro for element-wise comparisons between an array and a python
+// sequence, producing a bool array
+#define VTOPERATOR_WRAP_PYTYPE_BOOL_BASE(func,arg1,arg2,expr)               \
+    template <typename T> static                                            \
+    VtArray<bool> Vt##func(arg1, arg2) {                                    \
+        size_t length = len(obj);                                           \
+        if (length != vec.size()) {                                         \
+            TfPyThrowValueError("Non-conforming inputs for " #func);        \
+            return VtArray<bool>();                                         \
+        }                                                                   \
+        VtArray<bool> ret(vec.size());                                      \
+        for (size_t i = 0; i < length; ++i) {                               \
+            if (!extract<T>(obj[i]).check())                                \
+                TfPyThrowValueError("Element is of incorrect type.");       \
+            ret[i] = expr;                                                  \
+        }                                                                   \
+        return ret;                                                         \
+    }
+
 // array OP pytype
 // pytype OP array
 #define VTOPERATOR_WRAP_PYTYPE_BOOL(func,pytype,op)         \
@@ -118,6 +162,31 @@ struct _ArrayPyOpHelp<bool> {
 #define VTOPERATOR_WRAP_BOOL(func,op)                       \
         VTOPERATOR_WRAP_PYTYPE_BOOL(func,list,op)           \
         VTOPERATOR_WRAP_PYTYPE_BOOL(func,tuple,op)          
+
+// to be used to declare the wrapping of a comparison function with def(),
+// for all combinations of arrays, scalars, tuples and lists
+#define VTOPERATOR_WRAPDECLARE_BOOL(func)                   \
+        def(#func,(VtArray<bool> (*)                        \
+          (VtArray<T> const &,VtArray<T> const &))          \
+          Vt##func<T>);                                     \
+        def(#func,(VtArray<bool> (*)                        \
+          (T const &,VtArray<T> const &))                   \
+          Vt##func<T>);                                     \
+        def(#func,(VtArray<bool> (*)                        \
+          (VtArray<T> const &,T const &))                   \
+          Vt##func<T>);                                     \
+        def(#func,(VtArray<bool> (*)                        \
+          (VtArray<T> const &,tuple const &))               \
+          Vt##func<T>);                                     \
+        def(#func,(VtArray<bool> (*)                        \
+          (tuple const &,VtArray<T> const &))               \
+          Vt##func<T>);                                     \
+        def(#func,(VtArray<bool> (*)                        \
+          (VtArray<T> const &,list const &))                \
+          Vt##func<T>);                                     \
+        def(#func,(VtArray<bool> (*)                        \
+          (list const &,VtArray<T> const &))                \
+          Vt##func<T>);
                       
 
 VT_NAMESPACE_CLOSE_SCOPE
@@ -178,6 +178,28 @@ using TF_PP_CAT(Vt, TF_PP_CAT(VT_TYPE_NAME(elem), ArrayEditBuilder)) \
     = VtArrayEditBuilder< VT_TYPE(elem) >;
 TF_PP_SEQ_FOR_EACH(VT_ARRAY_EDIT_BUILDER_ALIAS, ~, VT_SCALAR_VALUE_TYPES)
 
+// The following preprocessor code produces type aliases for VtArrayEditPlan
+// holding various scalar value types.  The produced aliases are of the form:
+//
+// using VtIntArrayEditPlan = VtArrayEditPlan<int>;
+// using VtDoubleArrayEditPlan = VtArrayEditPlan<double>;
+template<typename T> class VtArrayEditPlan;
+#define VT_ARRAY_EDIT_PLAN_ALIAS(unused, elem) \
+using TF_PP_CAT(Vt, TF_PP_CAT(VT_TYPE_NAME(elem), ArrayEditPlan)) \
+    = VtArrayEditPlan< VT_TYPE(elem) >;
+TF_PP_SEQ_FOR_EACH(VT_ARRAY_EDIT_PLAN_ALIAS, ~, VT_SCALAR_VALUE_TYPES)
+
+// The following preprocessor code produces type aliases for VtArrayEditView
+// holding various scalar value types.  The produced aliases are of the form:
+//
+// using VtIntArrayEditView = VtArrayEditView<int>;
+// using VtDoubleArrayEditView = VtArrayEditView<double>;
+template<typename T> class VtArrayEditView;
+#define VT_ARRAY_EDIT_VIEW_ALIAS(unused, elem) \
+using TF_PP_CAT(Vt, TF_PP_CAT(VT_TYPE_NAME(elem), ArrayEditView)) \
+    = VtArrayEditView< VT_TYPE(elem) >;
+TF_PP_SEQ_FOR_EACH(VT_ARRAY_EDIT_VIEW_ALIAS, ~, VT_SCALAR_VALUE_TYPES)
+
 // The following preprocessor code generates the boost pp sequence for
 // all array value types (VT_ARRAY_VALUE_TYPES)
 #define VT_ARRAY_TYPE_TUPLE(unused, elem) \
@@ -11,6 +11,7 @@
 #include "pxr/vt/typeHeaders.h"
 #include "pxr/vt/types.h"
 #include "pxr/vt/dictionary.h"
+#include "pxr/vt/functions.h"
 
 #include <pxr/gf/math.h>
 #include <pxr/gf/numericCast.h>
@@ -22,15 +23,24 @@
 #include <pxr/tf/staticData.h>
 #include <pxr/tf/token.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/spin_mutex.h>
 #include <tbb/concurrent_unordered_map.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
 #include <limits>
@@ -58,13 +68,372 @@ _NumericCast(VtValue const &val)
     return opt ? VtValue(opt.value()) : VtValue();
 }
 
-template <class A, class B>
-static void _RegisterNumericCasts()
+// Disambiguate TfToken->string conversion
+static VtValue
+_TfTokenToString(VtValue const &val)
+{
+    return VtValue(val.UncheckedGet<TfToken>().GetString());
+}
+
+static VtValue
+_TfStringToToken(VtValue const &val)
+{
+    return VtValue(TfToken(val.UncheckedGet<std::string>()));
+}
+
+template <class From, class To>
+static VtValue
+_SimpleCast(VtValue const &val)
+{
+    return VtValue(To(val.UncheckedGet<From>()));
+}
+
+// A function object that converts a GfRange type to another GfRange type.
+template <class ToRng>
+struct _ConvertRng {
+    template <class FromRng>
+    inline ToRng operator()(FromRng const &from) const {
+        return ToRng(typename ToRng::MinMaxType(from.GetMin()),
+                     typename ToRng::MinMaxType(from.GetMax()));
+    }
+};
+
+// Floating point array conversions.  These use VtArrayConvert(), which
+// converts large arrays in parallel with vectorizable loops.
+template <class FromArray, class ToArray>
+static VtValue
+_ConvertArray(VtValue const &array)
+{
+    ToArray dst = VtArrayConvert<typename ToArray::ElementType>(
+        array.Get<FromArray>());
+    return VtValue::Take(dst);
+}
+
+template <class FromArray, class ToArray>
+static VtValue
+_ConvertRangeArray(VtValue const &array)
+{
+    typedef typename ToArray::ElementType ToRng;
+    ToArray dst = VtArrayConvert<ToRng>(
+        array.Get<FromArray>(), _ConvertRng<ToRng>());
+    return VtValue::Take(dst);
+}
+
+using Vt_CastFn = VtValue (*)(VtValue const &);
+
+// Numeric types with built-in casts that are not known value types on every
+// platform, since which of them int64_t and uint64_t name varies.
+using Vt_OtherCastTypeList = TfMetaList<
+    signed char, long, unsigned long, long long, unsigned long long>;
+
+// Casts are looked up by type indexes: the known value type index, or one
+// past the known value types for the types in Vt_OtherCastTypeList.
+static constexpr int _NumCastTypes = VtGetNumKnownValueTypes() +
+    TfMetaApply<TfMetaLength, Vt_OtherCastTypeList>::value;
+
+// Return the cast type index of T, or -1 if T has none.
+template <class T>
+static constexpr int
+_CastTypeIndexOf()
+{
+    constexpr int knownIndex = Vt_KnownValueTypeDetail::GetIndex<T>();
+    constexpr int otherIndex =
+        Vt_KnownValueTypeDetail::GetIndexImpl<T>(Vt_OtherCastTypeList{});
+    return knownIndex >= 0 ? knownIndex :
+        otherIndex >= 0 ? VtGetNumKnownValueTypes() + otherIndex : -1;
+}
+
+template <class A, class B, class Visitor>
+static constexpr void
+_AddNumericCasts(Visitor &visitor)
+{
+    visitor.template Add<A, B>(_NumericCast<A, B>);
+    visitor.template Add<B, A>(_NumericCast<B, A>);
+}
+
+template <class A, class B, class Visitor>
+static constexpr void
+_AddSimpleBidirectionalCasts(Visitor &visitor)
 {
-    VtValue::RegisterCast<A, B>(_NumericCast<A, B>);
-    VtValue::RegisterCast<B, A>(_NumericCast<B, A>);
+    visitor.template Add<A, B>(_SimpleCast<A, B>);
+    visitor.template Add<B, A>(_SimpleCast<B, A>);
 }
 
+template <class A1, class A2, class Visitor>
+static constexpr void
+_AddArrayCasts(Visitor &visitor)
+{
+    visitor.template Add<A1, A2>(_ConvertArray<A1, A2>);
+    visitor.template Add<A2, A1>(_ConvertArray<A2, A1>);
+}
+
+template <class A1, class A2, class Visitor>
+static constexpr void
+_AddRangeArrayCasts(Visitor &visitor)
+{
+    visitor.template Add<A1, A2>(_ConvertRangeArray<A1, A2>);
+    visitor.template Add<A2, A1>(_ConvertRangeArray<A2, A1>);
+}
+
+// Call visitor.Add<From, To>(castFn) for each of the casts that VtValue
+// provides without any registration.
+template <class Visitor>
+static constexpr void
+_VisitBuiltinCasts(Visitor &visitor)
+{
+    _AddNumericCasts<bool, char>(visitor);
+    _AddNumericCasts<bool, signed char>(visitor);
+    _AddNumericCasts<bool, unsigned char>(visitor);
+    _AddNumericCasts<bool, short>(visitor);
+    _AddNumericCasts<bool, unsigned short>(visitor);
+    _AddNumericCasts<bool, int>(visitor);
+    _AddNumericCasts<bool, unsigned int>(visitor);
+    _AddNumericCasts<bool, long>(visitor);
+    _AddNumericCasts<bool, unsigned long>(visitor);
+    _AddNumericCasts<bool, long long>(visitor);
+    _AddNumericCasts<bool, unsigned long long>(visitor);
+    _AddNumericCasts<bool, GfHalf>(visitor);
+    _AddNumericCasts<bool, float>(visitor);
+    _AddNumericCasts<bool, double>(visitor);
+
+    _AddNumericCasts<char, signed char>(visitor);
+    _AddNumericCasts<char, unsigned char>(visitor);
+    _AddNumericCasts<char, short>(visitor);
+    _AddNumericCasts<char, unsigned short>(visitor);
+    _AddNumericCasts<char, int>(visitor);
+    _AddNumericCasts<char, unsigned int>(visitor);
+    _AddNumericCasts<char, long>(visitor);
+    _AddNumericCasts<char, unsigned long>(visitor);
+    _AddNumericCasts<char, long long>(visitor);
+    _AddNumericCasts<char, unsigned long long>(visitor);
+    _AddNumericCasts<char, GfHalf>(visitor);
+    _AddNumericCasts<char, float>(visitor);
+    _AddNumericCasts<char, double>(visitor);
+
+    _AddNumericCasts<signed char, unsigned char>(visitor);
+    _AddNumericCasts<signed char, short>(visitor);
+    _AddNumericCasts<signed char, unsigned short>(visitor);
+    _AddNumericCasts<signed char, int>(visitor);
+    _AddNumericCasts<signed char, unsigned int>(visitor);
+    _AddNumericCasts<signed char, long>(visitor);
+    _AddNumericCasts<signed char, unsigned long>(visitor);
+    _AddNumericCasts<signed char, long long>(visitor);
+    _AddNumericCasts<signed char, unsigned long long>(visitor);
+    _AddNumericCasts<signed char, GfHalf>(visitor);
+    _AddNumericCasts<signed char, float>(visitor);
+    _AddNumericCasts<signed char, double>(visitor);
+
+    _AddNumericCasts<unsigned char, short>(visitor);
+    _AddNumericCasts<unsigned char, unsigned short>(visitor);
+    _AddNumericCasts<unsigned char, int>(visitor);
+    _AddNumericCasts<unsigned char, unsigned int>(visitor);
+    _AddNumericCasts<unsigned char, long>(visitor);
+    _AddNumericCasts<unsigned char, unsigned long>(visitor);
+    _AddNumericCasts<unsigned char, long long>(visitor);
+    _AddNumericCasts<unsigned char, unsigned long long>(visitor);
+    _AddNumericCasts<unsigned char, GfHalf>(visitor);
+    _AddNumericCasts<unsigned char, float>(visitor);
+    _AddNumericCasts<unsigned char, double>(visitor);
+
+    _AddNumericCasts<short, unsigned short>(visitor);
+    _AddNumericCasts<short, int>(visitor);
+    _AddNumericCasts<short, unsigned int>(visitor);
+    _AddNumericCasts<short, long>(visitor);
+    _AddNumericCasts<short, unsigned long>(visitor);
+    _AddNumericCasts<short, long long>(visitor);
+    _AddNumericCasts<short, unsigned long long>(visitor);
+    _AddNumericCasts<short, GfHalf>(visitor);
+    _AddNumericCasts<short, float>(visitor);
+    _AddNumericCasts<short, double>(visitor);
+
+    _AddNumericCasts<unsigned short, int>(visitor);
+    _AddNumericCasts<unsigned short, unsigned int>(visitor);
+    _AddNumericCasts<unsigned short, long>(visitor);
+    _AddNumericCasts<unsigned short, unsigned long>(visitor);
+    _AddNumericCasts<unsigned short, long long>(visitor);
+    _AddNumericCasts<unsigned short, unsigned long long>(visitor);
+    _AddNumericCasts<unsigned short, GfHalf>(visitor);
+    _AddNumericCasts<unsigned short, float>(visitor);
+    _AddNumericCasts<unsigned short, double>(visitor);
+
+    _AddNumericCasts<int, unsigned int>(visitor);
+    _AddNumericCasts<int, long>(visitor);
+    _AddNumericCasts<int, unsigned long>(visitor);
+    _AddNumericCasts<int, long long>(visitor);
+    _AddNumericCasts<int, unsigned long long>(visitor);
+    _AddNumericCasts<int, GfHalf>(visitor);
+    _AddNumericCasts<int, float>(visitor);
+    _AddNumericCasts<int, double>(visitor);
+
+    _AddNumericCasts<unsigned int, long>(visitor);
+    _AddNumericCasts<unsigned int, unsigned long>(visitor);
+    _AddNumericCasts<unsigned int, long long>(visitor);
+    _AddNumericCasts<unsigned int, unsigned long long>(visitor);
+    _AddNumericCasts<unsigned int, GfHalf>(visitor);
+    _AddNumericCasts<unsigned int, float>(visitor);
+    _AddNumericCasts<unsigned int, double>(visitor);
+
+    _AddNumericCasts<long, unsigned long>(visitor);
+    _AddNumericCasts<long, long long>(visitor);
+    _AddNumericCasts<long, unsigned long long>(visitor);
+    _AddNumericCasts<long, GfHalf>(visitor);
+    _AddNumericCasts<long, float>(visitor);
+    _AddNumericCasts<long, double>(visitor);
+
+    _AddNumericCasts<unsigned long, long long>(visitor);
+    _AddNumericCasts<unsigned long, unsigned long long>(visitor);
+    _AddNumericCasts<unsigned long, GfHalf>(visitor);
+    _AddNumericCasts<unsigned long, float>(visitor);
+    _AddNumericCasts<unsigned long, double>(visitor);
+
+    _AddNumericCasts<long long, unsigned long long>(visitor);
+    _AddNumericCasts<long long, GfHalf>(visitor);
+    _AddNumericCasts<long long, float>(visitor);
+    _AddNumericCasts<long long, double>(visitor);
+
+    _AddNumericCasts<unsigned long long, GfHalf>(visitor);
+    _AddNumericCasts<unsigned long long, float>(visitor);
+    _AddNumericCasts<unsigned long long, double>(visitor);
+
+    _AddNumericCasts<GfHalf, float>(visitor);
+    _AddNumericCasts<GfHalf, double>(visitor);
+
+    _AddNumericCasts<float, double>(visitor);
+
+
+    visitor.template Add<TfToken, std::string>(_TfTokenToString);
+    visitor.template Add<std::string, TfToken>(_TfStringToToken);
+
+    visitor.template Add<GfVec2i, GfVec2h>(_SimpleCast<GfVec2i, GfVec2h>);
+    visitor.template Add<GfVec2i, GfVec2f>(_SimpleCast<GfVec2i, GfVec2f>);
+    visitor.template Add<GfVec2i, GfVec2d>(_SimpleCast<GfVec2i, GfVec2d>);
+    _AddSimpleBidirectionalCasts<GfVec2h, GfVec2d>(visitor);
+    _AddSimpleBidirectionalCasts<GfVec2h, GfVec2f>(visitor);
+    _AddSimpleBidirectionalCasts<GfVec2f, GfVec2d>(visitor);
+
+    visitor.template Add<GfVec3i, GfVec3h>(_SimpleCast<GfVec3i, GfVec3h>);
+    visitor.template Add<GfVec3i, GfVec3f>(_SimpleCast<GfVec3i, GfVec3f>);
+    visitor.template Add<GfVec3i, GfVec3d>(_SimpleCast<GfVec3i, GfVec3d>);
+    _AddSimpleBidirectionalCasts<GfVec3h, GfVec3d>(visitor);
+    _AddSimpleBidirectionalCasts<GfVec3h, GfVec3f>(visitor);
+    _AddSimpleBidirectionalCasts<GfVec3f, GfVec3d>(visitor);
+
+    visitor.template Add<GfVec4i, GfVec4h>(_SimpleCast<GfVec4i, GfVec4h>);
+    visitor.template Add<GfVec4i, GfVec4f>(_SimpleCast<GfVec4i, GfVec4f>);
+    visitor.template Add<GfVec4i, GfVec4d>(_SimpleCast<GfVec4i, GfVec4d>);
+    _AddSimpleBidirectionalCasts<GfVec4h, GfVec4d>(visitor);
+    _AddSimpleBidirectionalCasts<GfVec4h, GfVec4f>(visitor);
+    _AddSimpleBidirectionalCasts<GfVec4f, GfVec4d>(visitor);
+
+    // Precision casts.
+    _AddArrayCasts<VtHalfArray, VtFloatArray>(visitor);
+    _AddArrayCasts<VtHalfArray, VtDoubleArray>(visitor);
+    _AddArrayCasts<VtFloatArray, VtDoubleArray>(visitor);
+    _AddArrayCasts<VtVec2hArray, VtVec2fArray>(visitor);
+    _AddArrayCasts<VtVec2hArray, VtVec2dArray>(visitor);
+    _AddArrayCasts<VtVec2fArray, VtVec2dArray>(visitor);
+    _AddArrayCasts<VtVec3hArray, VtVec3fArray>(visitor);
+    _AddArrayCasts<VtVec3hArray, VtVec3dArray>(visitor);
+    _AddArrayCasts<VtVec3fArray, VtVec3dArray>(visitor);
+    _AddArrayCasts<VtVec4hArray, VtVec4fArray>(visitor);
+    _AddArrayCasts<VtVec4hArray, VtVec4dArray>(visitor);
+    _AddArrayCasts<VtVec4fArray, VtVec4dArray>(visitor);
+
+    // Not sure how necessary these are; here for consistency
+    _AddRangeArrayCasts<VtRange1fArray, VtRange1dArray>(visitor);
+    _AddRangeArrayCasts<VtRange2fArray, VtRange2dArray>(visitor);
+    _AddRangeArrayCasts<VtRange3fArray, VtRange3dArray>(visitor);
+}
+
+struct Vt_BuiltinCastCounter {
+    template <class From, class To>
+    constexpr void Add(Vt_CastFn) {
+        ++count;
+    }
+    int count = 0;
+};
+
+static constexpr int
+_CountBuiltinCasts()
+{
+    Vt_BuiltinCastCounter counter;
+    _VisitBuiltinCasts(counter);
+    return counter.count;
+}
+
+// The built-in casts, built at compile time so that they need no
+// registration at startup.  The dense table holds 1-based indexes into the
+// list of cast functions rather than the functions themselves, which keeps it
+// small and free of relocations.
+struct Vt_BuiltinCastTable {
+    static constexpr int NumCasts = _CountBuiltinCasts();
+
+    template <class From, class To>
+    constexpr void Add(Vt_CastFn castFn) {
+        static_assert(_CastTypeIndexOf<From>() >= 0 &&
+                      _CastTypeIndexOf<To>() >= 0, "");
+        castFns[++numCastFns] = castFn;
+        castIndexes[_CastTypeIndexOf<From>() * _NumCastTypes +
+                    _CastTypeIndexOf<To>()] =
+            static_cast<uint16_t>(numCastFns);
+    }
+
+    Vt_CastFn Find(int fromIndex, int toIndex) const {
+        return castFns[castIndexes[fromIndex * _NumCastTypes + toIndex]];
+    }
+
+    uint16_t castIndexes[_NumCastTypes * _NumCastTypes] = {};
+    Vt_CastFn castFns[NumCasts + 1] = {};
+    int numCastFns = 0;
+};
+
+static_assert(Vt_BuiltinCastTable::NumCasts <
+              std::numeric_limits<uint16_t>::max(), "");
+
+static constexpr Vt_BuiltinCastTable _builtinCastTable = [] {
+    Vt_BuiltinCastTable table;
+    _VisitBuiltinCasts(table);
+    return table;
+}();
+
+// A cast found by Vt_CastRegistry::FindCaster(): a single cast function or a
+// chain of them, applied in order until one fails.
+class Vt_Caster {
+public:
+    Vt_Caster() = default;
+
+    explicit Vt_Caster(Vt_CastFn castFn)
+        : _castFn(castFn) {}
+
+    explicit Vt_Caster(std::vector<Vt_CastFn> const *chain)
+        : _chain(chain) {}
+
+    explicit operator bool() const {
+        return _castFn || _chain;
+    }
+
+    VtValue operator()(VtValue const &val) const {
+        if (_castFn) {
+            return _castFn(val);
+        }
+        if (!_chain) {
+            return VtValue();
+        }
+        VtValue result = val;
+        for (Vt_CastFn castFn: *_chain) {
+            result = castFn(result);
+            if (result.IsEmpty()) {
+                break;
+            }
+        }
+        return result;
+    }
+
+private:
+    Vt_CastFn _castFn = nullptr;
+    std::vector<Vt_CastFn> const *_chain = nullptr;
+};
+
 class Vt_CastRegistry {
 
   public:
@@ -80,8 +449,17 @@ class Vt_CastRegistry {
         std::type_index src = from;
         std::type_index dst = to;
 
-        bool isNewEntry = _conversions.insert(
-            std::make_pair(_ConversionSourceToTarget(src, dst), castFn)).second;
+        // Casts between types with cast type indexes are looked up by their
+        // indexes, first among the built-in casts and then in the dense
+        // table of registered casts.
+        const int fromIndex = _GetCastTypeIndex(from);
+        const int toIndex = _GetCastTypeIndex(to);
+        const bool isIndexedCast = fromIndex >= 0 && toIndex >= 0;
+
+        bool isNewEntry =
+            !(isIndexedCast && _builtinCastTable.Find(fromIndex, toIndex)) &&
+            _conversions.insert(std::make_pair(
+                _ConversionSourceToTarget(src, dst), castFn)).second;
         if (!isNewEntry) {
             // This happens at startup if there's a bug in the code.
             TF_CODING_ERROR("VtValue cast already registered from "
@@ -90,182 +468,258 @@ class Vt_CastRegistry {
                             ArchGetDemangled(to).c_str());
             return;
         }
+
+        if (isIndexedCast) {
+            _GetIndexedCast(fromIndex, toIndex).store(
+                castFn, std::memory_order_release);
+        }
+
+        // Cached cast paths may no longer be the shortest, or may now exist.
+        _generation.fetch_add(1, std::memory_order_release);
     }
 
-    VtValue PerformCast(type_info const &to, VtValue const &val) {
+    VtValue PerformCast(type_info const &to, int toIndex,
+                        VtValue const &val, int fromIndex) {
         if (val.IsEmpty())
             return val;
 
-        std::type_index src = val.GetTypeid();
-        std::type_index dst = to;
+        return FindCaster(val.GetTypeid(), fromIndex, to, toIndex)(val);
+    }
 
-        VtValue (*castFn)(VtValue const &) = NULL;
+    bool CanCast(type_info const &from, int fromIndex,
+                 type_info const &to, int toIndex) {
+        return static_cast<bool>(FindCaster(from, fromIndex, to, toIndex));
+    }
 
-        _Conversions::iterator c = _conversions.find({src, dst});
-        if (c != _conversions.end()) {
-            castFn = c->second;
+    // Return the cast from \p from to \p to: a single cast, a chain of casts
+    // if transitive casts are enabled, or a null caster if there is none.
+    Vt_Caster FindCaster(type_info const &from, int fromIndex,
+                         type_info const &to, int toIndex) {
+        if (Vt_CastFn castFn = _FindCast(from, fromIndex, to, toIndex)) {
+            return Vt_Caster(castFn);
+        }
+        if (_transitiveCastsEnabled.load(std::memory_order_relaxed)) {
+            if (_CastPath const *path = _FindCastPath(from, to)) {
+                return Vt_Caster(&path->casts);
+            }
         }
-        return castFn ? castFn(val) : VtValue();
+        return Vt_Caster();
     }
 
-    bool CanCast(type_info const &from, type_info const &to) {
-        std::type_index src = from;
-        std::type_index dst = to;
+    void SetTransitiveCastsEnabled(bool enabled) {
+        _transitiveCastsEnabled.store(enabled, std::memory_order_relaxed);
+    }
 
-        return _conversions.find({src, dst}) != _conversions.end();
+    bool GetTransitiveCastsEnabled() const {
+        return _transitiveCastsEnabled.load(std::memory_order_relaxed);
     }
 
   private:
-    Vt_CastRegistry() {
+    Vt_CastRegistry()
+        : _indexedConversions(new std::atomic<Vt_CastFn>[
+                                  _NumCastTypes * _NumCastTypes]())
+        , _castTypes(_NumCastTypes) {
         TfSingleton<Vt_CastRegistry>::SetInstanceConstructed(*this);
-        _RegisterBuiltinCasts();
+        _AddCastTypeIndexes(Vt_ValueTypeList{});
+        _AddCastTypeIndexes(Vt_OtherCastTypeList{});
+        // The built-in casts are in _builtinCastTable, so this only runs the
+        // registration functions of other libraries and plugins.
         TfRegistryManager::GetInstance().SubscribeTo<VtValue>();
     }
     virtual ~Vt_CastRegistry() {}
     friend class TfSingleton<Vt_CastRegistry>;
 
-    // Disambiguate TfToken->string conversion
-    static VtValue _TfTokenToString(VtValue const &val) {
-        return VtValue(val.UncheckedGet<TfToken>().GetString());
-    }
-    static VtValue _TfStringToToken(VtValue const &val) {
-        return VtValue(TfToken(val.UncheckedGet<std::string>()));
-    }
-
-    void _RegisterBuiltinCasts() {
-        _RegisterNumericCasts<bool, char>();
-        _RegisterNumericCasts<bool, signed char>();
-        _RegisterNumericCasts<bool, unsigned char>();
-        _RegisterNumericCasts<bool, short>();
-        _RegisterNumericCasts<bool, unsigned short>();
-        _RegisterNumericCasts<bool, int>();
-        _RegisterNumericCasts<bool, unsigned int>();
-        _RegisterNumericCasts<bool, long>();
-        _RegisterNumericCasts<bool, unsigned long>();
-        _RegisterNumericCasts<bool, long long>();
-        _RegisterNumericCasts<bool, unsigned long long>();
-        _RegisterNumericCasts<bool, GfHalf>();
-        _RegisterNumericCasts<bool, float>();
-        _RegisterNumericCasts<bool, double>();
-
-        _RegisterNumericCasts<char, signed char>();
-        _RegisterNumericCasts<char, unsigned char>();
-        _RegisterNumericCasts<char, short>();
-        _RegisterNumericCasts<char, unsigned short>();
-        _RegisterNumericCasts<char, int>();
-        _RegisterNumericCasts<char, unsigned int>();
-        _RegisterNumericCasts<char, long>();
-        _RegisterNumericCasts<char, unsigned long>();
-        _RegisterNumericCasts<char, long long>();
-        _RegisterNumericCasts<char, unsigned long long>();
-        _RegisterNumericCasts<char, GfHalf>();
-        _RegisterNumericCasts<char, float>();
-        _RegisterNumericCasts<char, double>();
-
-        _RegisterNumericCasts<signed char, unsigned char>();
-        _RegisterNumericCasts<signed char, short>();
-        _RegisterNumericCasts<signed char, unsigned short>();
-        _RegisterNumericCasts<signed char, int>();
-        _RegisterNumericCasts<signed char, unsigned int>();
-        _RegisterNumericCasts<signed char, long>();
-        _RegisterNumericCasts<signed char, unsigned long>();
-        _RegisterNumericCasts<signed char, long long>();
-        _RegisterNumericCasts<signed char, unsigned long long>();
-        _RegisterNumericCasts<signed char, GfHalf>();
-        _RegisterNumericCasts<signed char, float>();
-        _RegisterNumericCasts<signed char, double>();
-
-        _RegisterNumericCasts<unsigned char, short>();
-        _RegisterNumericCasts<unsigned char, unsigned short>();
-        _RegisterNumericCasts<unsigned char, int>();
-        _RegisterNumericCasts<unsigned char, unsigned int>();
-        _RegisterNumericCasts<unsigned char, long>();
-        _RegisterNumericCasts<unsigned char, unsigned long>();
-        _RegisterNumericCasts<unsigned char, long long>();
-        _RegisterNumericCasts<unsigned char, unsigned long long>();
-        _RegisterNumericCasts<unsigned char, GfHalf>();
-        _RegisterNumericCasts<unsigned char, float>();
-        _RegisterNumericCasts<unsigned char, double>();
-
-        _RegisterNumericCasts<short, unsigned short>();
-        _RegisterNumericCasts<short, int>();
-        _RegisterNumericCasts<short, unsigned int>();
-        _RegisterNumericCasts<short, long>();
-        _RegisterNumericCasts<short, unsigned long>();
-        _RegisterNumericCasts<short, long long>();
-        _RegisterNumericCasts<short, unsigned long long>();
-        _RegisterNumericCasts<short, GfHalf>();
-        _RegisterNumericCasts<short, float>();
-        _RegisterNumericCasts<short, double>();
-
-        _RegisterNumericCasts<unsigned short, int>();
-        _RegisterNumericCasts<unsigned short, unsigned int>();
-        _RegisterNumericCasts<unsigned short, long>();
-        _RegisterNumericCasts<unsigned short, unsigned long>();
-        _RegisterNumericCasts<unsigned short, long long>();
-        _RegisterNumericCasts<unsigned short, unsigned long long>();
-        _RegisterNumericCasts<unsigned short, GfHalf>();
-        _RegisterNumericCasts<unsigned short, float>();
-        _RegisterNumericCasts<unsigned short, double>();
-
-        _RegisterNumericCasts<int, unsigned int>();
-        _RegisterNumericCasts<int, long>();
-        _RegisterNumericCasts<int, unsigned long>();
-        _RegisterNumericCasts<int, long long>();
-        _RegisterNumericCasts<int, unsigned long long>();
-        _RegisterNumericCasts<int, GfHalf>();
-        _RegisterNumericCasts<int, float>();
-        _RegisterNumericCasts<int, double>();
-
-        _RegisterNumericCasts<unsigned int, long>();
-        _RegisterNumericCasts<unsigned int, unsigned long>();
-        _RegisterNumericCasts<unsigned int, long long>();
-        _RegisterNumericCasts<unsigned int, unsigned long long>();
-        _RegisterNumericCasts<unsigned int, GfHalf>();
-        _RegisterNumericCasts<unsigned int, float>();
-        _RegisterNumericCasts<unsigned int, double>();
-
-        _RegisterNumericCasts<long, unsigned long>();
-        _RegisterNumericCasts<long, long long>();
-        _RegisterNumericCasts<long, unsigned long long>();
-        _RegisterNumericCasts<long, GfHalf>();
-        _RegisterNumericCasts<long, float>();
-        _RegisterNumericCasts<long, double>();
-
-        _RegisterNumericCasts<unsigned long, long long>();
-        _RegisterNumericCasts<unsigned long, unsigned long long>();
-        _RegisterNumericCasts<unsigned long, GfHalf>();
-        _RegisterNumericCasts<unsigned long, float>();
-        _RegisterNumericCasts<unsigned long, double>();
-
-        _RegisterNumericCasts<long long, unsigned long long>();
-        _RegisterNumericCasts<long long, GfHalf>();
-        _RegisterNumericCasts<long long, float>();
-        _RegisterNumericCasts<long long, double>();
-
-        _RegisterNumericCasts<unsigned long long, GfHalf>();
-        _RegisterNumericCasts<unsigned long long, float>();
-        _RegisterNumericCasts<unsigned long long, double>();
-
-        _RegisterNumericCasts<GfHalf, float>();
-        _RegisterNumericCasts<GfHalf, double>();
-
-        _RegisterNumericCasts<float, double>();
-
-        VtValue::RegisterCast<TfToken, std::string>(_TfTokenToString);
-        VtValue::RegisterCast<std::string, TfToken>(_TfStringToToken);
-    } 
+    template <class... Types>
+    void _AddCastTypeIndexes(TfMetaList<Types...>) {
+        (_castTypeIndexes.emplace(typeid(Types), _CastTypeIndexOf<Types>()),
+         ...);
+        ((_castTypes[_CastTypeIndexOf<Types>()] = &typeid(Types)), ...);
+    }
+
+    // Return the cast type index of \p type, or -1 if it has none.
+    int _GetCastTypeIndex(type_info const &type) const {
+        auto it = _castTypeIndexes.find(type);
+        return it != _castTypeIndexes.end() ? it->second : -1;
+    }
+
+    std::atomic<Vt_CastFn> &_GetIndexedCast(int fromIndex, int toIndex) const {
+        return _indexedConversions[fromIndex * _NumCastTypes + toIndex];
+    }
+
+    // Return the cast from \p from to \p to, or null if there is none.
+    // Casts between types with cast type indexes are looked up by their
+    // indexes, others by hashing their type_infos.  Callers pass the known
+    // value type index or -1, so look up the indexes of other types and of
+    // values held by proxies here.
+    Vt_CastFn _FindCast(type_info const &from, int fromIndex,
+                        type_info const &to, int toIndex) const {
+        if (fromIndex < 0) {
+            fromIndex = _GetCastTypeIndex(from);
+        }
+        if (fromIndex >= 0 && toIndex < 0) {
+            toIndex = _GetCastTypeIndex(to);
+        }
+        if (fromIndex >= 0 && toIndex >= 0) {
+            if (Vt_CastFn castFn =
+                    _builtinCastTable.Find(fromIndex, toIndex)) {
+                return castFn;
+            }
+            return _GetIndexedCast(fromIndex, toIndex).load(
+                std::memory_order_acquire);
+        }
+        _Conversions::const_iterator c = _conversions.find(
+            {std::type_index(from), std::type_index(to)});
+        return c != _conversions.end() ? c->second : nullptr;
+    }
 
     using _ConversionSourceToTarget =
         std::pair<std::type_index, std::type_index>;
 
     using _Conversions = tbb::concurrent_unordered_map<
         _ConversionSourceToTarget,
-        VtValue (*)(VtValue const &),
+        Vt_CastFn,
+        TfHash>;
+
+    // A chain of casts found by _FindCastPath(), which is the shortest as of
+    // the registry generation \a generation.  An empty chain means there was
+    // no path.
+    struct _CastPath {
+        std::vector<Vt_CastFn> casts;
+        std::atomic<size_t> generation;
+    };
+
+    // Return the shortest chain of casts from \p from to \p to, or null if
+    // there is none.  The result for each pair of types is searched for once
+    // and then cached until another cast is registered; looking up a cached
+    // result takes no locks.
+    _CastPath const *_FindCastPath(type_info const &from,
+                                   type_info const &to) {
+        const size_t generation = _generation.load(std::memory_order_acquire);
+        const _ConversionSourceToTarget key(from, to);
+        _CastPaths::const_iterator i = _castPaths.find(key);
+        if (i != _castPaths.end()) {
+            _CastPath const *path = i->second.load(std::memory_order_acquire);
+            if (path->generation.load(std::memory_order_acquire) ==
+                generation) {
+                return path->casts.empty() ? nullptr : path;
+            }
+        }
+        _CastPath const *path = _SearchCastPath(key, generation);
+        return path->casts.empty() ? nullptr : path;
+    }
+
+    // Search the graph of built-in and registered casts breadth-first for the
+    // shortest chain of casts for \p key, and cache it.
+    _CastPath const *_SearchCastPath(_ConversionSourceToTarget const &key,
+                                     size_t generation) {
+        std::lock_guard<std::mutex> lock(_castPathMutex);
+
+        // Another thread may have searched while we waited.
+        _CastPaths::const_iterator i = _castPaths.find(key);
+        _CastPath *cached = i != _castPaths.end() ?
+            i->second.load(std::memory_order_acquire) : nullptr;
+        if (cached &&
+            cached->generation.load(std::memory_order_acquire) == generation) {
+            return cached;
+        }
+
+        if (_castGraphGeneration != generation) {
+            _castGraph.clear();
+            for (int from = 0; from != _NumCastTypes; ++from) {
+                for (int to = 0; to != _NumCastTypes; ++to) {
+                    if (Vt_CastFn castFn = _builtinCastTable.Find(from, to)) {
+                        _castGraph[*_castTypes[from]].emplace_back(
+                            *_castTypes[to], castFn);
+                    }
+                }
+            }
+            for (auto const &conversion: _conversions) {
+                _castGraph[conversion.first.first].emplace_back(
+                    conversion.first.second, conversion.second);
+            }
+            _castGraphGeneration = generation;
+        }
+
+        // Map each type reached to the type and cast it was reached by.
+        std::unordered_map<
+            std::type_index, std::pair<std::type_index, Vt_CastFn>> reachedBy;
+        std::vector<std::type_index> queue { key.first };
+        reachedBy.emplace(key.first, std::make_pair(key.first, nullptr));
+        for (size_t i = 0; i != queue.size() && !reachedBy.count(key.second);
+             ++i) {
+            auto edges = _castGraph.find(queue[i]);
+            if (edges == _castGraph.end()) {
+                continue;
+            }
+            for (auto const &edge: edges->second) {
+                if (reachedBy.emplace(edge.first, std::make_pair(
+                            queue[i], edge.second)).second) {
+                    queue.push_back(edge.first);
+                }
+            }
+        }
+
+        std::vector<Vt_CastFn> casts;
+        auto reached = reachedBy.find(key.second);
+        if (reached != reachedBy.end()) {
+            for (; reached->second.second;
+                 reached = reachedBy.find(reached->second.first)) {
+                casts.push_back(reached->second.second);
+            }
+            std::reverse(casts.begin(), casts.end());
+        }
+
+        // Most registrations leave most paths unchanged.  Then mark the
+        // cached path as current rather than storing a new one, so that
+        // readers holding it can keep using it.
+        if (cached && cached->casts == casts) {
+            cached->generation.store(generation, std::memory_order_release);
+            return cached;
+        }
+
+        // Readers may still hold the path this replaces, so keep every path
+        // for the lifetime of the registry.  Paths are only replaced when a
+        // registration changes the shortest chain for a pair of types, so
+        // this holds one path per pair of types cast between plus one per
+        // such change.
+        std::unique_ptr<_CastPath> path(new _CastPath);
+        path->casts = std::move(casts);
+        path->generation.store(generation, std::memory_order_relaxed);
+        _CastPath *result = path.get();
+        _allCastPaths.push_back(std::move(path));
+        auto inserted = _castPaths.emplace(key, result);
+        if (!inserted.second) {
+            inserted.first->second.store(result, std::memory_order_release);
+        }
+        return result;
+    }
+
+    using _CastPaths = tbb::concurrent_unordered_map<
+        _ConversionSourceToTarget,
+        std::atomic<_CastPath *>,
         TfHash>;
 
     _Conversions _conversions;
-    
+
+    // Registered casts between types with cast type indexes, indexed by
+    // fromIndex * _NumCastTypes + toIndex.
+    std::unique_ptr<std::atomic<Vt_CastFn>[]> _indexedConversions;
+    std::unordered_map<std::type_index, int> _castTypeIndexes;
+    std::vector<type_info const *> _castTypes;
+
+    // Transitive casts.  _generation counts registrations, and cached paths
+    // found in earlier generations are searched for again.
+    std::atomic<bool> _transitiveCastsEnabled { false };
+    std::atomic<size_t> _generation { 0 };
+    _CastPaths _castPaths;
+
+    // The cast graph and path storage, guarded by _castPathMutex.
+    std::mutex _castPathMutex;
+    std::unordered_map<
+        std::type_index,
+        std::vector<std::pair<std::type_index, Vt_CastFn>>> _castGraph;
+    size_t _castGraphGeneration = static_cast<size_t>(-1);
+    std::vector<std::unique_ptr<_CastPath>> _allCastPaths;
 };
 TF_INSTANTIATE_SINGLETON(Vt_CastRegistry);
 
@@ -371,6 +825,92 @@ VtValue::CastToTypeid(VtValue const &val, std::type_info const &type) {
     return ret.CastToTypeid(type);
 }
 
+void
+VtValue::CastBatch(TfSpan<VtValue const> values,
+                   std::type_info const &type,
+                   TfSpan<VtValue> result)
+{
+    if (values.size() != result.size()) {
+        TF_CODING_ERROR("Cannot cast %zu values into %zu results.",
+                        values.size(), result.size());
+        return;
+    }
+
+    // Runs of values of this many or more that hold the same type are cast in
+    // parallel.
+    constexpr size_t parallelRunSize = 4096;
+
+    // The casts found so far, by held type.
+    struct _Group {
+        type_info const *from;
+        int fromIndex;
+        Vt_Caster caster;
+        bool isIdentity;
+    };
+    std::vector<_Group> groups;
+
+    Vt_CastRegistry &registry = Vt_CastRegistry::GetInstance();
+    for (size_t begin = 0, end; begin != values.size(); begin = end) {
+        VtValue const &first = values[begin];
+        if (first.IsEmpty()) {
+            result[begin] = VtValue();
+            end = begin + 1;
+            continue;
+        }
+
+        // Find the run of values holding the same type as first.
+        type_info const &from = first.GetTypeid();
+        const int fromIndex = first._GetKnownTypeIndexIfNotProxy();
+        for (end = begin + 1; end != values.size(); ++end) {
+            VtValue const &val = values[end];
+            if (fromIndex >= 0 ?
+                val._GetKnownTypeIndexIfNotProxy() != fromIndex :
+                val.IsEmpty() || !TfSafeTypeCompare(val.GetTypeid(), from)) {
+                break;
+            }
+        }
+
+        // Look up the cast once per held type.
+        auto group = std::find_if(
+            groups.begin(), groups.end(), [&](_Group const &other) {
+                return fromIndex >= 0 ? other.fromIndex == fromIndex :
+                    TfSafeTypeCompare(*other.from, from);
+            });
+        if (group == groups.end()) {
+            const bool isIdentity = TfSafeTypeCompare(from, type);
+            groups.push_back({
+                &from, fromIndex,
+                isIdentity ? Vt_Caster() :
+                registry.FindCaster(from, fromIndex, type, -1),
+                isIdentity });
+            group = std::prev(groups.end());
+        }
+
+        auto castRange = [&values, &result, &group](size_t i, size_t iEnd) {
+            if (group->isIdentity) {
+                for (; i != iEnd; ++i) {
+                    result[i] = values[i];
+                }
+            }
+            else {
+                for (; i != iEnd; ++i) {
+                    result[i] = group->caster(values[i]);
+                }
+            }
+        };
+        if (end - begin >= parallelRunSize) {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(begin, end),
+                [&castRange](tbb::blocked_range<size_t> const &r) {
+                    castRange(r.begin(), r.end());
+                });
+        }
+        else {
+            castRange(begin, end);
+        }
+    }
+}
+
 void VtValue::_RegisterCast(type_info const &from,
                             type_info const &to,
                             VtValue (*castFn)(VtValue const &))
@@ -378,17 +918,31 @@ void VtValue::_RegisterCast(type_info const &from,
     Vt_CastRegistry::GetInstance().Register(from, to, castFn);
 }
 
-VtValue VtValue::_PerformCast(type_info const &to, VtValue const &val)
+VtValue VtValue::_PerformCast(type_info const &to, int toKnownIndex,
+                              VtValue const &val)
 {
     TF_DEV_AXIOM(!TfSafeTypeCompare(val.GetTypeid(), to));
-    return Vt_CastRegistry::GetInstance().PerformCast(to, val);
+    return Vt_CastRegistry::GetInstance().PerformCast(
+        to, toKnownIndex, val, val._GetKnownTypeIndexIfNotProxy());
+}
+
+void VtValue::SetTransitiveCastsEnabled(bool enabled)
+{
+    Vt_CastRegistry::GetInstance().SetTransitiveCastsEnabled(enabled);
+}
+
+bool VtValue::GetTransitiveCastsEnabled()
+{
+    return Vt_CastRegistry::GetInstance().GetTransitiveCastsEnabled();
 }
 
-bool VtValue::_CanCast(type_info const &from, type_info const &to)
+bool VtValue::_CanCast(type_info const &from, int fromKnownIndex,
+                       type_info const &to, int toKnownIndex)
 {
     if (TfSafeTypeCompare(from, to))
         return true;
-    return Vt_CastRegistry::GetInstance().CanCast(from, to);
+    return Vt_CastRegistry::GetInstance().CanCast(
+        from, fromKnownIndex, to, toKnownIndex);
 }
 
 bool
@@ -25,6 +25,7 @@
 #include <pxr/tf/pointerAndBits.h>
 #include <pxr/tf/preprocessorUtilsLite.h>
 #include <pxr/tf/safeTypeCompare.h>
+#include <pxr/tf/span.h>
 #include <pxr/tf/stringUtils.h>
 #include <pxr/tf/tf.h>
 #include <pxr/tf/type.h>
@@ -131,6 +132,11 @@ using Vt_ValueGetStored = Vt_ValueStoredType<std::decay_t<T>>;
 /// \endcode
 /// block.
 ///
+/// By default a cast succeeds only if a cast is registered directly between
+/// the two types.  SetTransitiveCastsEnabled() lets a cast go through a chain
+/// of registered casts instead, so that clients need not register casts
+/// between every pair of their types.
+///
 /// \subsection VtValue_builtin_conversions Builtin Type Conversion
 ///
 /// Conversions between most of the basic "value types" that are intrinsically
@@ -179,12 +185,17 @@ class VtValue
         }
     };
 
-    // Hold objects up to 1 word large locally.  This makes the total structure
-    // 16 bytes when compiled 64 bit (1 word type-info pointer, 1 word storage
-    // space).
-    static const size_t _MaxLocalSize = sizeof(void*);
+    // Hold objects up to VT_VALUE_LOCAL_STORAGE_SIZE bytes large locally.  By
+    // default this is 1 word, which makes the total structure 16 bytes when
+    // compiled 64 bit (1 word type-info pointer, 1 word storage space).
+    // Builds that configure more storage trade a larger VtValue for holding
+    // types like GfVec3f, GfVec4f or GfVec3d without a heap allocation, or
+    // with 40 bytes, VtArray.
+    static const size_t _MaxLocalSize =
+        VT_VALUE_LOCAL_STORAGE_SIZE > sizeof(void*) ?
+        VT_VALUE_LOCAL_STORAGE_SIZE : sizeof(void*);
     typedef std::aligned_storage<
-        /* size */_MaxLocalSize, /* alignment */_MaxLocalSize>::type _Storage;
+        /* size */_MaxLocalSize, /* alignment */alignof(void*)>::type _Storage;
 
     template <class T>
     using _IsTriviallyCopyable = std::integral_constant<bool,
@@ -194,11 +205,18 @@ class VtValue
         std::is_trivially_destructible_v<T>>;
 
     // Metafunction that returns true if T should be stored locally, false if it
-    // should be stored remotely.
+    // should be stored remotely.  VtArrays are stored locally when they fit,
+    // since copying one only bumps the reference count it shares with other
+    // arrays, where a remote holder would add an allocation and a second
+    // count.  A VtArray is 40 bytes on 64-bit platforms, so only builds with
+    // VT_VALUE_LOCAL_STORAGE_SIZE set to 40 get this; default builds still
+    // hold VtArrays remotely.  Get() returns a reference to the held VtArray,
+    // so it cannot be held more compactly than that.
     template <class T>
     using _UsesLocalStore = std::integral_constant<bool,
         (sizeof(T) <= sizeof(_Storage)) &&
-        VtValueTypeHasCheapCopy<T>::value &&
+        (alignof(T) <= alignof(_Storage)) &&
+        (VtValueTypeHasCheapCopy<T>::value || VtIsArray<T>::value) &&
         std::is_nothrow_move_constructible<T>::value &&
         std::is_nothrow_move_assignable<T>::value>;
 
@@ -1193,14 +1211,43 @@ public:
     VT_API static VtValue
     CastToTypeid(VtValue const &val, std::type_info const &type);
 
+    /// Cast each of \p values to \p type, storing the results in \p result,
+    /// which must be the same size as \p values and may be the same span.
+    /// Each result is what CastToTypeid() would return, but the cast for each
+    /// held type is looked up once rather than once per value, and long runs
+    /// of values holding the same type are cast in parallel.
+    ///
+    /// \sa \ref VtValue_Casting
+    VT_API static void
+    CastBatch(TfSpan<VtValue const> values,
+              std::type_info const &type,
+              TfSpan<VtValue> result);
+
     /// Return if a value of type \a from can be cast to type \a to.
     ///
     /// \sa \ref VtValue_Casting
     static bool CanCastFromTypeidToTypeid(std::type_info const &from,
                                           std::type_info const &to) {
-        return _CanCast(from, to);
+        return _CanCast(from, -1, to, -1);
     }
 
+    /// Enable or disable transitive casts.  When enabled, a cast between two
+    /// types with no cast registered between them is performed by the
+    /// shortest chain of registered casts, if there is one: for example, a
+    /// client type with a cast registered only to double can then be cast to
+    /// float, through double.  The chain fails if any cast in it fails.  The
+    /// chain for each pair of types, or the lack of one, is found once and
+    /// cached until another cast is registered.  Transitive casts are
+    /// disabled by default.
+    ///
+    /// \sa \ref VtValue_Casting
+    VT_API static void SetTransitiveCastsEnabled(bool enabled);
+
+    /// Return true if transitive casts are enabled.
+    ///
+    /// \sa SetTransitiveCastsEnabled()
+    VT_API static bool GetTransitiveCastsEnabled();
+
     /// Return \c this holding value type cast to T.  This value is left
     /// empty if the cast fails.
     ///
@@ -1212,7 +1259,8 @@ public:
     VtValue &Cast() {
         if (IsHolding<T>())
             return *this;
-        return *this = _PerformCast(typeid(T), *this);
+        return *this = _PerformCast(
+            typeid(T), Vt_KnownValueTypeDetail::GetIndex<T>(), *this);
     }
 
     /// Return \c this holding value type cast to same type that
@@ -1223,7 +1271,12 @@ public:
     ///
     /// \sa \ref VtValue_Casting
     VtValue &CastToTypeOf(VtValue const &other) {
-        return CastToTypeid(other.GetTypeid());
+        std::type_info const &type = other.GetTypeid();
+        if (!TfSafeTypeCompare(GetTypeid(), type)) {
+            *this = _PerformCast(type, other._GetKnownTypeIndexIfNotProxy(),
+                                 *this);
+        }
+        return *this;
     }
 
     /// Return \c this holding value type cast to \a type.  This value is
@@ -1235,7 +1288,7 @@ public:
     /// \sa \ref VtValue_Casting
     VtValue &CastToTypeid(std::type_info const &type) {
         if (!TfSafeTypeCompare(GetTypeid(), type)) {
-            *this = _PerformCast(type, *this);
+            *this = _PerformCast(type, -1, *this);
         }
         return *this;
     }
@@ -1245,21 +1298,25 @@ public:
     /// \sa \ref VtValue_Casting
     template <typename T>
     bool CanCast() const {
-        return _CanCast(GetTypeid(), typeid(T));
+        return _CanCast(GetTypeid(), _GetKnownTypeIndexIfNotProxy(),
+                        typeid(T), Vt_KnownValueTypeDetail::GetIndex<T>());
     }
 
     /// Return if \c this can be cast to \a type.
     ///
     /// \sa \ref VtValue_Casting
     bool CanCastToTypeOf(VtValue const &other) const {
-        return _CanCast(GetTypeid(), other.GetTypeid());
+        return _CanCast(GetTypeid(), _GetKnownTypeIndexIfNotProxy(),
+                        other.GetTypeid(),
+                        other._GetKnownTypeIndexIfNotProxy());
     }
 
     /// Return if \c this can be cast to \a type.
     ///
     /// \sa \ref VtValue_Casting
     bool CanCastToTypeid(std::type_info const &type) const {
-        return _CanCast(GetTypeid(), type);
+        return _CanCast(GetTypeid(), _GetKnownTypeIndexIfNotProxy(),
+                        type, -1);
     }
 
     /// Returns true iff this value is empty.
@@ -1429,19 +1486,32 @@ ARCH_PRAGMA_POP
         return _info.BitsAs<unsigned int>() & _ProxyFlag;
     }
 
+    // Return the known value type index of the held type, or -1 if this value
+    // is empty, holds a proxy, or holds a type that is not known.  Unlike
+    // GetKnownValueTypeIndex(), this never resolves a proxy.
+    inline int _GetKnownTypeIndexIfNotProxy() const {
+        return _info.GetLiteral() && !_IsProxy() ? _info->knownTypeIndex : -1;
+    }
+
     VT_API static void _RegisterCast(std::type_info const &from,
                                      std::type_info const &to,
                                      VtValue (*castFn)(VtValue const &));
 
     // Cast \p value to the type \p to.  Caller must ensure that val's type is
-    // not already \p to.
+    // not already \p to.  \p toKnownIndex is the known value type index of
+    // \p to, or -1 if it is unknown or not a known type.  Casts between known
+    // types are found in a table indexed by type, others by hashing the
+    // type_infos.
     VT_API static VtValue
-    _PerformCast(std::type_info const &to, VtValue const &val);
+    _PerformCast(std::type_info const &to, int toKnownIndex,
+                 VtValue const &val);
  
     // Return true if \p from == \p to or if there is a registered cast to
-    // convert VtValues holding \p from to \p to.
+    // convert VtValues holding \p from to \p to.  The known value type
+    // indexes are as for _PerformCast().
     VT_API static bool
-    _CanCast(std::type_info const &from, std::type_info const &to);
+    _CanCast(std::type_info const &from, int fromKnownIndex,
+             std::type_info const &to, int toKnownIndex);
 
     // helper template function for simple casts from From to To.
     template <typename From, typename To>
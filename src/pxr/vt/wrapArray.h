@@ -11,6 +11,7 @@
 #include "pxr/vt/pxr.h"
 #include "pxr/vt/api.h"
 #include "pxr/vt/array.h"
+#include "pxr/vt/functions.h"
 #include "pxr/vt/types.h"
 #include "pxr/vt/value.h"
 #include "pxr/vt/pyOperators.h"
@@ -33,6 +34,7 @@
 #include <pxr/tf/tf.h>
 #include <pxr/tf/wrapTypeHelpers.h>
 
+#include <pxr/boost/python/args.hpp>
 #include <pxr/boost/python/class.hpp>
 #include <pxr/boost/python/copy_const_reference.hpp>
 #include <pxr/boost/python/def.hpp>
@@ -45,6 +47,7 @@
 #include <pxr/boost/python/operators.hpp>
 #include <pxr/boost/python/return_arg.hpp>
 #include <pxr/boost/python/slice.hpp>
+#include <pxr/boost/python/tuple.hpp>
 #include <pxr/boost/python/type_id.hpp>
 #include <pxr/boost/python/overloads.hpp>
 
@@ -53,6 +56,8 @@
 #include <ostream>
 #include <string>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 VT_NAMESPACE_OPEN_SCOPE
@@ -381,6 +386,36 @@ VtArray<T> *VtArray__init__2(size_t size, object const &values)
     return ret.release();
 }
 
+// Arrays with at least this many elements have their element-wise work done
+// without holding the GIL, so that other python threads can run meanwhile.
+// For smaller arrays it is not worth releasing and reacquiring the GIL.
+constexpr size_t _AllowThreadsMinSize = 2 * Vt_FunctionsDetail::GrainSize;
+
+// Return fn(), releasing the GIL while it runs if size is large enough.  fn
+// must not touch any python objects, nor refer to arrays they own: another
+// python thread could modify or release those meanwhile.  Instead fn should
+// capture copies of the arrays, which are made while the GIL is held and share
+// their data, so that copy-on-write isolates the reads.
+template <typename Fn>
+static auto
+_AllowThreadsIfLarge(size_t size, Fn const &fn)
+{
+    if (size >= _AllowThreadsMinSize) {
+        TfPyAllowThreadsInScope allowThreads;
+        return fn();
+    }
+    return fn();
+}
+
+template <typename T>
+static VtArray<T>
+_Neg(VtArray<T> const &self)
+{
+    return _AllowThreadsIfLarge(self.size(), [self]() {
+        return VtArray<T>(-self);
+    });
+}
+
 // overloading for operator special methods, to allow tuple / list & array
 // combinations
 ARCH_PRAGMA_PUSH
@@ -390,10 +425,35 @@ ARCH_PRAGMA_UNARY_MINUS_ON_UNSIGNED
 VTOPERATOR_WRAP(__add__,__radd__)
 VTOPERATOR_WRAP_NONCOMM(__sub__,__rsub__)
 VTOPERATOR_WRAP(__mul__,__rmul__)
-VTOPERATOR_WRAP_NONCOMM(__div__,__rdiv__)
+VTOPERATOR_WRAP_NONCOMM(__truediv__,__rtruediv__)
 VTOPERATOR_WRAP_NONCOMM(__mod__,__rmod__)
 
+VTOPERATOR_WRAP_ALLOW_THREADS(+,_Add)
+VTOPERATOR_WRAP_ALLOW_THREADS(-,_Sub)
+VTOPERATOR_WRAP_ALLOW_THREADS(*,_Mul)
+VTOPERATOR_WRAP_ALLOW_THREADS(/,_Div)
+VTOPERATOR_WRAP_ALLOW_THREADS(%,_Mod)
+
+VTOPERATOR_WRAP_BOOL(Equal,==)
+VTOPERATOR_WRAP_BOOL(NotEqual,!=)
+VTOPERATOR_WRAP_BOOL(Greater,>)
+VTOPERATOR_WRAP_BOOL(Less,<)
+VTOPERATOR_WRAP_BOOL(GreaterOrEqual,>=)
+VTOPERATOR_WRAP_BOOL(LessOrEqual,<=)
+
 ARCH_PRAGMA_POP
+
+// Whether T supports the ordering comparisons.
+template <typename T, typename = void>
+struct _IsOrdered : std::false_type {};
+
+template <typename T>
+struct _IsOrdered<T, std::void_t<
+    decltype(std::declval<T>() < std::declval<T>()),
+    decltype(std::declval<T>() > std::declval<T>()),
+    decltype(std::declval<T>() <= std::declval<T>()),
+    decltype(std::declval<T>() >= std::declval<T>())>>
+    : std::true_type {};
 }
 
 template <typename T>
@@ -453,29 +513,35 @@ void VtWrapArray()
 #endif
 
 #ifdef ADDITION_OPERATOR
+        VTOPERATOR_WRAPDECLARE_ALLOW_THREADS(_Add,__add__,__radd__,Type)
         VTOPERATOR_WRAPDECLARE(+,__add__,__radd__)
 #endif
 #ifdef SUBTRACTION_OPERATOR
+        VTOPERATOR_WRAPDECLARE_ALLOW_THREADS(_Sub,__sub__,__rsub__,Type)
         VTOPERATOR_WRAPDECLARE(-,__sub__,__rsub__)
 #endif
 #ifdef MULTIPLICATION_OPERATOR
+        VTOPERATOR_WRAPDECLARE_ALLOW_THREADS(_Mul,__mul__,__rmul__,Type)
         VTOPERATOR_WRAPDECLARE(*,__mul__,__rmul__)
 #endif
 #ifdef DIVISION_OPERATOR
-        VTOPERATOR_WRAPDECLARE(/,__div__,__rdiv__)
+        VTOPERATOR_WRAPDECLARE_ALLOW_THREADS(
+            _Div,__truediv__,__rtruediv__,Type)
+        VTOPERATOR_WRAPDECLARE(/,__truediv__,__rtruediv__)
 #endif
 #ifdef MOD_OPERATOR
+        VTOPERATOR_WRAPDECLARE_ALLOW_THREADS(_Mod,__mod__,__rmod__,Type)
         VTOPERATOR_WRAPDECLARE(%,__mod__,__rmod__)
 #endif
 #ifdef DOUBLE_MULT_OPERATOR
-        .def(self * double())
-        .def(double() * self)
+        .def("__mul__", _Mul_scalar<Type, double>)
+        .def("__rmul__", _Mul_rscalar<Type, double>)
 #endif
 #ifdef DOUBLE_DIV_OPERATOR
-        .def(self / double())
+        .def("__truediv__", _Div_scalar<Type, double>)
 #endif
 #ifdef UNARY_NEG_OPERATOR
-        .def(- self)
+        .def("__neg__", _Neg<Type>)
 #endif
 
         ;
@@ -491,6 +557,132 @@ void VtWrapArray()
     implicitly_convertible<This, TfSpan<const Type> >();
 }
 
+// Wrap the comparison and mask functions for element type T.  This is
+// outside Vt_WrapArray so that the sequence overloads declared there
+// overload the array and scalar versions from functions.h rather than hide
+// them.
+template <typename T>
+void Vt_WrapComparisonFunctions()
+{
+    using namespace Vt_WrapArray;
+
+    VTOPERATOR_WRAPDECLARE_BOOL(Equal)
+    VTOPERATOR_WRAPDECLARE_BOOL(NotEqual)
+
+    if constexpr (_IsOrdered<T>::value) {
+        VTOPERATOR_WRAPDECLARE_BOOL(Greater)
+        VTOPERATOR_WRAPDECLARE_BOOL(Less)
+        VTOPERATOR_WRAPDECLARE_BOOL(GreaterOrEqual)
+        VTOPERATOR_WRAPDECLARE_BOOL(LessOrEqual)
+    }
+
+    def("ArraySelect", VtArraySelect<T>,
+        (arg("mask"), arg("a"), arg("b")));
+    def("ArrayCompress", VtArrayCompress<T>,
+        (arg("array"), arg("mask")));
+}
+
+/// Wrap the element-wise comparison functions for VtArray type \p T, along
+/// with the functions that take their resulting masks.
+template <typename T>
+void VtWrapComparisonFunctions()
+{
+    Vt_WrapComparisonFunctions<typename T::ElementType>();
+}
+
+template <typename T>
+static pxr_boost::python::tuple
+Vt_ArrayMakeIndexed(VtArray<T> const &array)
+{
+    VtArray<T> values;
+    VtIntArray indices;
+    VtArrayMakeIndexed(array, &values, &indices);
+    return pxr_boost::python::make_tuple(values, indices);
+}
+
+/// Wrap the functions for converting between indexed and dense forms of
+/// VtArray type \p T.
+template <typename T>
+void VtWrapIndexingFunctions()
+{
+    using namespace Vt_WrapArray;
+
+    typedef typename T::ElementType Type;
+
+    def("ArrayGather", VtArrayGather<Type>,
+        (arg("values"), arg("indices")));
+    def("ArrayScatter", VtArrayScatter<Type>,
+        (arg("values"), arg("indices"), arg("dest")));
+    def("ArrayMakeIndexed", Vt_ArrayMakeIndexed<Type>, (arg("array")));
+}
+
+template <typename T>
+static T
+Vt_ArraySum(VtArray<T> const &array, bool deterministic)
+{
+    return Vt_WrapArray::_AllowThreadsIfLarge(
+        array.size(), [array, deterministic]() {
+            return VtArraySum(array, deterministic);
+        });
+}
+
+template <typename T>
+static T
+Vt_ArrayMin(VtArray<T> const &array)
+{
+    T min;
+    if (!Vt_WrapArray::_AllowThreadsIfLarge(array.size(), [array, &min]() {
+            return VtArrayMinMax(array, &min, nullptr);
+        })) {
+        TfPyThrowValueError("ArrayMin() arg is an empty array");
+    }
+    return min;
+}
+
+template <typename T>
+static T
+Vt_ArrayMax(VtArray<T> const &array)
+{
+    T max;
+    if (!Vt_WrapArray::_AllowThreadsIfLarge(array.size(), [array, &max]() {
+            return VtArrayMinMax(array, nullptr, &max);
+        })) {
+        TfPyThrowValueError("ArrayMax() arg is an empty array");
+    }
+    return max;
+}
+
+template <typename T>
+static auto
+Vt_ArrayDot(VtArray<T> const &a, VtArray<T> const &b, bool deterministic)
+{
+    return Vt_WrapArray::_AllowThreadsIfLarge(
+        a.size(), [a, b, deterministic]() {
+            return VtArrayDot(a, b, deterministic);
+        });
+}
+
+/// Wrap the reductions over VtArray type \p T.  These run natively, without
+/// holding the GIL for large arrays.
+template <typename T>
+void VtWrapReductionFunctions()
+{
+    using namespace Vt_WrapArray;
+
+    typedef typename T::ElementType Type;
+
+    if constexpr (!std::is_same_v<Type, bool>) {
+        def("ArraySum", Vt_ArraySum<Type>,
+            (arg("array"), arg("deterministic") = false));
+    }
+    def("ArrayMin", Vt_ArrayMin<Type>, (arg("array")));
+    def("ArrayMax", Vt_ArrayMax<Type>, (arg("array")));
+    if constexpr (Vt_FunctionsDetail::IsFlat<Type>) {
+        def("ArrayDot", Vt_ArrayDot<Type>,
+            (arg("a"), arg("b"), arg("deterministic") = false));
+    }
+}
+
 template <class Array>
 VtValue
 Vt_ConvertFromPySequenceOrIter(TfPyObjWrapper const &obj)
@@ -575,6 +767,15 @@ void VtRegisterValueCastsFromPythonSequencesToArray()
 #define VT_WRAP_ARRAY(unused, elem)          \
     VtWrapArray< VtArray< VT_TYPE(elem) > >();
 
+#define VT_WRAP_COMPARISON(unused, elem)     \
+    VtWrapComparisonFunctions< VtArray< VT_TYPE(elem) > >();
+
+#define VT_WRAP_INDEXING(unused, elem)       \
+    VtWrapIndexingFunctions< VtArray< VT_TYPE(elem) > >();
+
+#define VT_WRAP_REDUCTION(unused, elem)      \
+    VtWrapReductionFunctions< VtArray< VT_TYPE(elem) > >();
+
 VT_NAMESPACE_CLOSE_SCOPE
 
 #endif // PXR_VT_WRAP_ARRAY_H
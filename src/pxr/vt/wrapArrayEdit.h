@@ -16,8 +16,10 @@
 #include "pxr/vt/wrapArray.h"
 
 #include <pxr/boost/python/class.hpp>
+#include <pxr/boost/python/tuple.hpp>
 
 #include <string>
+#include <vector>
 
 VT_NAMESPACE_OPEN_SCOPE
 
@@ -63,6 +65,21 @@ void VtWrapArrayEdit()
              +[](ArrayEdit const &self, ArrayEdit const &weaker) {
                  return self.ComposeOver(weaker);
              })
+        .def("ComposeStack",
+             +[](object const &edits) {
+                 std::vector<ArrayEdit> stack;
+                 for (Py_ssize_t i = 0, n = len(edits); i != n; ++i) {
+                     stack.push_back(extract<ArrayEdit>(edits[i]));
+                 }
+                 return ArrayEdit::ComposeStack(stack);
+             }, (arg("edits")))
+        .staticmethod("ComposeStack")
+        .def("ApplyWithInverse",
+             +[](ArrayEdit const &self, Array const &array) {
+                 ArrayEdit inverse;
+                 Array result = self.ApplyWithInverse(array, &inverse);
+                 return make_tuple(result, inverse);
+             }, (arg("array")))
         ;
     // Register the unboxing converter for ArrayEdit.
     to_python_converter<ArrayEdit, Wrapped>();
@@ -91,6 +108,22 @@ void VtWrapArrayEdit()
         .def("AppendRef", &Builder::AppendRef,
              (arg("srcIndex")), return_self<>())
         .def("EraseRef", &Builder::EraseRef, (arg("index")), return_self<>())
+        .def("WriteRange",
+             +[](Builder &self, Array const &elems, int64_t index) {
+                 self.WriteRange(elems, index);
+             }, (arg("elems"), arg("index")), return_self<>())
+        .def("WriteRefRange", &Builder::WriteRefRange,
+             (arg("srcIndex"), arg("dstIndex"), arg("count")),
+             return_self<>())
+        .def("InsertRange",
+             +[](Builder &self, Array const &elems, int64_t index) {
+                 self.InsertRange(elems, index);
+             }, (arg("elems"), arg("index")), return_self<>())
+        .def("InsertRefRange", &Builder::InsertRefRange,
+             (arg("srcIndex"), arg("dstIndex"), arg("count")),
+             return_self<>())
+        .def("EraseRange", &Builder::EraseRange,
+             (arg("index"), arg("count")), return_self<>())
         .def("MinSize",
              +[](Builder &self, int64_t size) {
                  self.MinSize(size);
@@ -114,6 +147,9 @@ void VtWrapArrayEdit()
             return Builder::Optimize(std::move(edit));
         }, (arg("edit")))
         .staticmethod("Optimize")
+        .def("Diff", &Builder::Diff,
+             (arg("oldArray"), arg("newArray"), arg("maxChanges") = 1024))
+        .staticmethod("Diff")
         ;
 }
 
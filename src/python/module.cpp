@@ -34,5 +34,6 @@ TF_WRAP_MODULE
     Vt_AddBufferProtocolSupportToVtArrays();
 
     TF_WRAP(Dictionary);
+    TF_WRAP(Functions);
     TF_WRAP(Value);
 }
@@ -22,4 +22,6 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayDualQuaternion() {
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY, ~, VT_DUALQUATERNION_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~, VT_DUALQUATERNION_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~, VT_DUALQUATERNION_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~, VT_DUALQUATERNION_VALUE_TYPES);
 }
@@ -20,4 +20,10 @@ void wrapArrayFloat() {
                        VT_FLOATING_POINT_BUILTIN_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~,
                        VT_FLOATING_POINT_BUILTIN_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~,
+                       VT_FLOATING_POINT_BUILTIN_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~,
+                       VT_FLOATING_POINT_BUILTIN_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_REDUCTION, ~,
+                       VT_FLOATING_POINT_BUILTIN_VALUE_TYPES);
 }
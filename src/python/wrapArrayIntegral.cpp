@@ -21,4 +21,10 @@ void wrapArrayIntegral() {
                        VT_INTEGRAL_BUILTIN_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~,
                        VT_INTEGRAL_BUILTIN_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~,
+                       VT_INTEGRAL_BUILTIN_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~,
+                       VT_INTEGRAL_BUILTIN_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_REDUCTION, ~,
+                       VT_INTEGRAL_BUILTIN_VALUE_TYPES);
 }
@@ -19,4 +19,6 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayMatrix() {
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY, ~, VT_MATRIX_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~, VT_MATRIX_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~, VT_MATRIX_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~, VT_MATRIX_VALUE_TYPES);
 }
@@ -22,4 +22,6 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayQuaternion() {
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY, ~, VT_QUATERNION_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~, VT_QUATERNION_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~, VT_QUATERNION_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~, VT_QUATERNION_VALUE_TYPES);
 }
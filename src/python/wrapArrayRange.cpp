@@ -18,4 +18,6 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayRange() {
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY, ~, VT_RANGE_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~, VT_RANGE_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~, VT_RANGE_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~, VT_RANGE_VALUE_TYPES);
 }
@@ -20,4 +20,6 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayString() {
     VtWrapArray<VtArray<string> >();
     VtWrapArrayEdit<VtArrayEdit<string> >();
+    VtWrapComparisonFunctions<VtArray<string> >();
+    VtWrapIndexingFunctions<VtArray<string> >();
 }
@@ -15,4 +15,6 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayToken() {
     VtWrapArray<VtArray<TfToken> >();
     VtWrapArrayEdit<VtArrayEdit<TfToken> >();
+    VtWrapComparisonFunctions<VtArray<TfToken> >();
+    VtWrapIndexingFunctions<VtArray<TfToken> >();
 }
@@ -33,4 +33,7 @@ VT_NAMESPACE_USING_DIRECTIVE
 void wrapArrayVec() {
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY, ~, VT_VEC_VALUE_TYPES);
     TF_PP_SEQ_FOR_EACH(VT_WRAP_ARRAY_EDIT, ~, VT_VEC_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_COMPARISON, ~, VT_VEC_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_INDEXING, ~, VT_VEC_VALUE_TYPES);
+    TF_PP_SEQ_FOR_EACH(VT_WRAP_REDUCTION, ~, VT_VEC_VALUE_TYPES);
 }
@@ -0,0 +1,107 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/vt/pxr.h>
+#include <pxr/vt/array.h>
+#include <pxr/vt/functions.h>
+#include <pxr/vt/types.h>
+
+#include <pxr/gf/dualQuatd.h>
+#include <pxr/gf/dualQuatf.h>
+#include <pxr/gf/dualQuath.h>
+#include <pxr/gf/matrix4d.h>
+#include <pxr/gf/quatd.h>
+#include <pxr/gf/quatf.h>
+#include <pxr/gf/quath.h>
+#include <pxr/gf/vec3d.h>
+#include <pxr/gf/vec3f.h>
+
+#include <pxr/boost/python/args.hpp>
+#include <pxr/boost/python/def.hpp>
+
+VT_NAMESPACE_USING_DIRECTIVE
+
+using namespace pxr_boost::python;
+
+namespace {
+
+template <class T, class Xf>
+VtArray<T>
+_TransformPoints(VtArray<T> const &points, Xf const &xf,
+                 bool accumulateInDouble)
+{
+    return VtArrayTransformPoints(points, xf, accumulateInDouble);
+}
+
+template <class T, class Xf>
+VtArray<T>
+_TransformDirections(VtArray<T> const &dirs, Xf const &xf,
+                     bool accumulateInDouble)
+{
+    return VtArrayTransformDirections(dirs, xf, accumulateInDouble);
+}
+
+template <class T, class Xf>
+VtArray<T>
+_TransformNormals(VtArray<T> const &normals, Xf const &xf,
+                  bool accumulateInDouble)
+{
+    return VtArrayTransformNormals(normals, xf, accumulateInDouble);
+}
+
+template <class T, class Xf>
+void
+_WrapTransforms(char const *xfName)
+{
+    def("ArrayTransformPoints", _TransformPoints<T, Xf>,
+        (arg("points"), arg(xfName), arg("accumulateInDouble") = true));
+    def("ArrayTransformDirections", _TransformDirections<T, Xf>,
+        (arg("dirs"), arg(xfName), arg("accumulateInDouble") = true));
+    def("ArrayTransformNormals", _TransformNormals<T, Xf>,
+        (arg("normals"), arg(xfName), arg("accumulateInDouble") = true));
+}
+
+template <class Q>
+void
+_WrapQuatFunctions()
+{
+    def("ArrayQuatNormalize", VtArrayQuatNormalize<Q>, (arg("quats")));
+    def("ArrayQuatMultiply", VtArrayQuatMultiply<Q>,
+        (arg("lhs"), arg("rhs")));
+    def("ArrayQuatSlerp", VtArrayQuatSlerp<Q>,
+        (arg("alpha"), arg("q0"), arg("q1")));
+    def("ArrayQuatRotate", VtArrayQuatRotate<Q, GfVec3f>,
+        (arg("quats"), arg("vecs")));
+    def("ArrayQuatRotate", VtArrayQuatRotate<Q, GfVec3d>,
+        (arg("quats"), arg("vecs")));
+}
+
+template <class DQ>
+void
+_WrapDualQuatFunctions()
+{
+    def("ArrayDualQuatBlend", VtArrayDualQuatBlend<DQ>,
+        (arg("dualQuats"), arg("indices"), arg("weights"),
+         arg("numInfluencesPerElement")));
+}
+
+} // anonymous namespace
+
+void wrapFunctions()
+{
+    _WrapTransforms<GfVec3f, GfMatrix4d>("matrix");
+    _WrapTransforms<GfVec3d, GfMatrix4d>("matrix");
+    _WrapTransforms<GfVec3f, VtMatrix4dArray>("matrices");
+    _WrapTransforms<GfVec3d, VtMatrix4dArray>("matrices");
+
+    _WrapQuatFunctions<GfQuath>();
+    _WrapQuatFunctions<GfQuatf>();
+    _WrapQuatFunctions<GfQuatd>();
+    _WrapDualQuatFunctions<GfDualQuath>();
+    _WrapDualQuatFunctions<GfDualQuatf>();
+    _WrapDualQuatFunctions<GfDualQuatd>();
+}
@@ -8,10 +8,19 @@
 #include <pxr/vt/pxr.h>
 #include <pxr/vt/arrayEdit.h>
 #include <pxr/vt/arrayEditBuilder.h>
+#include <pxr/vt/arrayEditPlan.h>
+#include <pxr/vt/arrayEditView.h>
 #include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
 #include <pxr/tf/stringUtils.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
 #include <cstdio>
+#include <functional>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -247,10 +256,863 @@ static void testBuilderAndComposition()
     }
 }
 
+// Build a random edit with many inserts and erases, with indexes chosen to be
+// in bounds for \p expected, and perform each operation on \p expected.
+static VtIntArrayEdit
+_MakeRandomEdit(std::mt19937 &gen, std::vector<int> *expected)
+{
+    auto randInt = [&gen](int64_t lo, int64_t hi) {
+        return std::uniform_int_distribution<int64_t>(lo, hi)(gen);
+    };
+    auto normalize = [expected](int64_t index) {
+        return index < 0 ? index + expected->size() : index;
+    };
+
+    VtIntArrayEditBuilder builder;
+    const int numOps = static_cast<int>(randInt(1, 40));
+    for (int i = 0; i != numOps; ++i) {
+        const int64_t size = expected->size();
+        const int value = static_cast<int>(randInt(100, 110));
+        switch (randInt(0, 13)) {
+        case 0:
+            if (size) {
+                const int64_t dst = randInt(-size, size - 1);
+                builder.Write(value, dst);
+                (*expected)[normalize(dst)] = value;
+            }
+            break;
+        case 1:
+            if (size) {
+                const int64_t src = randInt(-size, size - 1);
+                const int64_t dst = randInt(-size, size - 1);
+                builder.WriteRef(src, dst);
+                (*expected)[normalize(dst)] = (*expected)[normalize(src)];
+            }
+            break;
+        case 2: {
+            int64_t dst = randInt(-size, size + 1);
+            if (dst == size + 1) {
+                dst = VtIntArrayEditBuilder::EndIndex;
+            }
+            builder.Insert(value, dst);
+            expected->insert(
+                expected->begin() +
+                (dst == VtIntArrayEditBuilder::EndIndex ?
+                 size : normalize(dst)), value);
+            break;
+        }
+        case 3:
+            if (size) {
+                const int64_t src = randInt(-size, size - 1);
+                const int64_t dst = randInt(0, size);
+                builder.InsertRef(src, dst);
+                const int elem = (*expected)[normalize(src)];
+                expected->insert(expected->begin() + dst, elem);
+            }
+            break;
+        case 4:
+        case 5:
+            if (size) {
+                const int64_t idx = randInt(-size, size - 1);
+                builder.EraseRef(idx);
+                expected->erase(expected->begin() + normalize(idx));
+            }
+            break;
+        case 6: {
+            const int64_t newSize = randInt(0, 80);
+            builder.MinSize(newSize, value);
+            if (newSize > size) {
+                expected->resize(newSize, value);
+            }
+            break;
+        }
+        case 7: {
+            const int64_t newSize = randInt(0, 80);
+            builder.SetSize(newSize);
+            expected->resize(newSize);
+            break;
+        }
+        case 8: {
+            const int64_t newSize = randInt(0, 80);
+            builder.MaxSize(newSize);
+            expected->resize(std::min(size, newSize));
+            break;
+        }
+        case 9:
+            if (size) {
+                const int64_t dst = randInt(-size, size - 1);
+                VtIntArray elems(randInt(1, size - normalize(dst)), value);
+                builder.WriteRange(elems, dst);
+                std::copy(elems.begin(), elems.end(),
+                          expected->begin() + normalize(dst));
+            }
+            break;
+        case 10:
+            if (size) {
+                const int64_t src = randInt(-size, size - 1);
+                const int64_t dst = randInt(-size, size - 1);
+                const int64_t count = randInt(
+                    0, size - std::max(normalize(src), normalize(dst)));
+                builder.WriteRefRange(src, dst, count);
+                const std::vector<int> copied(
+                    expected->begin() + normalize(src),
+                    expected->begin() + normalize(src) + count);
+                std::copy(copied.begin(), copied.end(),
+                          expected->begin() + normalize(dst));
+            }
+            break;
+        case 11: {
+            const int64_t dst = randInt(-size, size);
+            VtIntArray elems(randInt(1, 8));
+            for (int &elem: elems) {
+                elem = static_cast<int>(randInt(100, 110));
+            }
+            builder.InsertRange(elems, dst);
+            expected->insert(expected->begin() + normalize(dst),
+                             elems.begin(), elems.end());
+            break;
+        }
+        case 12:
+            if (size) {
+                const int64_t src = randInt(-size, size - 1);
+                const int64_t dst = randInt(0, size);
+                const int64_t count = randInt(0, size - normalize(src));
+                builder.InsertRefRange(src, dst, count);
+                const std::vector<int> copied(
+                    expected->begin() + normalize(src),
+                    expected->begin() + normalize(src) + count);
+                expected->insert(expected->begin() + dst,
+                                 copied.begin(), copied.end());
+            }
+            break;
+        case 13:
+            if (size) {
+                const int64_t idx = randInt(-size, size - 1);
+                const int64_t count = randInt(0, size - normalize(idx));
+                builder.EraseRange(idx, count);
+                expected->erase(expected->begin() + normalize(idx),
+                                expected->begin() + normalize(idx) + count);
+            }
+            break;
+        };
+    }
+    return builder.FinalizeAndReset();
+}
+
+static VtIntArray
+_MakeIota(size_t size)
+{
+    VtIntArray result(size);
+    for (size_t i = 0; i != size; ++i) {
+        result[i] = static_cast<int>(i);
+    }
+    return result;
+}
+
+// Check that applying random edits produces the same result as performing
+// each operation in turn.
+static void testApplyInsertErase()
+{
+    std::mt19937 gen(1234);
+    for (int trial = 0; trial != 200; ++trial) {
+        const VtIntArray input = _MakeIota(gen() % 65);
+        std::vector<int> expected(input.begin(), input.end());
+        const VtIntArrayEdit edit = _MakeRandomEdit(gen, &expected);
+        CHECK_EQUAL(edit.ComposeOver(input).GetDenseArray(),
+                    VtIntArray(expected.begin(), expected.end()));
+    }
+
+    // Out-of-bounds operations are still ignored.
+    VtIntArrayEdit edit = VtIntArrayEditBuilder()
+        .Insert(5, 10)
+        .EraseRef(-10)
+        .InsertRef(1, 0)
+        .Append(7)
+        .FinalizeAndReset();
+    CHECK_EQUAL(edit.ComposeOver(VtIntArray{1,2,3}).GetDenseArray(),
+                (VtIntArray{2,1,2,3,7}));
+}
+
+static void testRanges()
+{
+    VtIntArrayEditBuilder builder;
+    const VtIntArray input = _MakeIota(8);
+
+    CHECK_EQUAL(builder.WriteRange(VtIntArray{7,7,7}, -4)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                (VtIntArray{0,1,2,3,7,7,7,7}));
+    CHECK_EQUAL(builder.InsertRange(VtIntArray{9,9}, 2)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                (VtIntArray{0,1,9,9,2,3,4,5,6,7}));
+    CHECK_EQUAL(builder.EraseRange(1, 5)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                (VtIntArray{0,6,7}));
+    CHECK_EQUAL(builder.InsertRefRange(-2, 0, 2)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                (VtIntArray{6,7,0,1,2,3,4,5,6,7}));
+
+    // Overlapping ref ranges copy as if through a temporary.
+    CHECK_EQUAL(builder.WriteRefRange(0, 2, 5)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                (VtIntArray{0,1,0,1,2,3,4,7}));
+    CHECK_EQUAL(builder.WriteRefRange(3, 1, 5)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                (VtIntArray{0,3,4,5,6,7,6,7}));
+
+    // Ranges that run out of bounds are ignored.
+    CHECK_EQUAL(builder
+                .WriteRange(VtIntArray{7,7,7}, 6)
+                .EraseRange(-9, 2)
+                .WriteRefRange(0, 4, 5)
+                .FinalizeAndReset().ComposeOver(input).GetDenseArray(),
+                input);
+
+    // A range is a single instruction, however long.
+    const VtIntArray ones(10000, 1);
+    const VtIntArrayEdit bulk = builder
+        .InsertRange(ones, VtIntArrayEditBuilder::EndIndex)
+        .FinalizeAndReset();
+    VtIntArray literals;
+    std::vector<int64_t> indexes;
+    VtIntArrayEditBuilder::GetSerializationData(bulk, &literals, &indexes);
+    TF_AXIOM(literals.size() == 10000);
+    TF_AXIOM(indexes.size() == 4);
+    TF_AXIOM(VtIntArrayEditBuilder::CreateFromSerializationData(
+                 literals, indexes, false) == bulk);
+    TF_AXIOM(bulk.ComposeOver(input).GetDenseArray().size() == 10008);
+}
+
+static void testParallelWrites()
+{
+    // Large write-only edits must act as if applied one write at a time.
+    const size_t size = 100000;
+    std::mt19937 gen(8642);
+    for (int trial = 0; trial != 6; ++trial) {
+        std::vector<int> expected(size);
+        for (size_t i = 0; i != size; ++i) {
+            expected[i] = static_cast<int>(i);
+        }
+
+        // Odd trials have references that read written elements too.
+        VtIntArrayEditBuilder builder;
+        for (int i = 0; i != 50000; ++i) {
+            const int64_t dst = gen() % size;
+            switch (gen() % 4) {
+            case 0: {
+                const int64_t src = trial % 2 ? gen() % size : size / 2;
+                builder.WriteRef(src, dst);
+                expected[dst] = expected[src];
+                break;
+            }
+            case 1:
+                if (dst + 3 <= static_cast<int64_t>(size) &&
+                    (dst > static_cast<int64_t>(size / 2) ||
+                     dst + 3 <= static_cast<int64_t>(size / 2))) {
+                    const std::vector<int> elems { -i, -i - 1, -i - 2 };
+                    builder.WriteRange(elems, dst);
+                    std::copy(elems.begin(), elems.end(),
+                              expected.begin() + dst);
+                }
+                break;
+            default:
+                // Avoid writing the shared reference source.
+                if (dst != static_cast<int64_t>(size / 2)) {
+                    builder.Write(-i, dst - size);
+                    expected[dst] = -i;
+                }
+                break;
+            }
+        }
+        const VtIntArray result =
+            builder.FinalizeAndReset().ComposeOver(_MakeIota(size))
+            .GetDenseArray();
+        CHECK_EQUAL(result, VtIntArray(expected.begin(), expected.end()));
+    }
+}
+
+static void testPlan()
+{
+    // Plans must act like ComposeOver() for arrays of any size.
+    std::mt19937 gen(4321);
+    for (int trial = 0; trial != 100; ++trial) {
+        const size_t inputSize = gen() % 65;
+        std::vector<int> unused(inputSize);
+        const VtIntArrayEdit edit = _MakeRandomEdit(gen, &unused);
+        const VtIntArrayEditPlan plan(edit, inputSize);
+        for (size_t size: { inputSize, inputSize + 1, size_t(0) }) {
+            const VtIntArray input = _MakeIota(size);
+            const VtIntArray result = plan.Apply(input);
+            CHECK_EQUAL(result, edit.ComposeOver(input).GetDenseArray());
+            if (size == inputSize) {
+                TF_AXIOM(result.size() == plan.GetOutputSize());
+            }
+        }
+    }
+
+    VtIntArrayEditBuilder builder;
+    const VtIntArray input = _MakeIota(6);
+
+    // Edits that leave the array unchanged share its data.
+    const VtIntArrayEditPlan noop(
+        builder.MinSize(4).MaxSize(10).EraseRef(9).FinalizeAndReset(), 6);
+    TF_AXIOM(noop.Apply(input).IsIdentical(input));
+    TF_AXIOM(VtIntArrayEditPlan().Apply(input).IsIdentical(input));
+    const VtIntArrayEditPlan resizeNoop(
+        builder.MinSize(4).MaxSize(10).FinalizeAndReset(), 6);
+    TF_AXIOM(resizeNoop.Apply(input).IsIdentical(input));
+
+    // Edits that only write and resize are applied in place.
+    const VtIntArrayEditPlan writes(
+        builder.Write(9, 3).SetSize(4).MinSize(5, 7).FinalizeAndReset(), 6);
+    TF_AXIOM(writes.GetOutputSize() == 5);
+    CHECK_EQUAL(writes.Apply(input), (VtIntArray{0,1,2,9,7}));
+    const VtIntArrayEditPlan shrinkAndGrow(
+        builder.SetSize(4).SetSize(6).FinalizeAndReset(), 6);
+    TF_AXIOM(shrinkAndGrow.GetOutputSize() == 6);
+    CHECK_EQUAL(shrinkAndGrow.Apply(input), (VtIntArray{0,1,2,3,0,0}));
+
+    // Negative indexes are resolved and out-of-range writes dropped when the
+    // plan is compiled.
+    const VtIntArrayEditPlan resolved(
+        builder.Write(9, -1).Write(8, 10).WriteRef(-2, 0).WriteRef(7, 1)
+        .MinSize(7, 5).Write(6, -1).FinalizeAndReset(), 6);
+    TF_AXIOM(resolved.GetOutputSize() == 7);
+    CHECK_EQUAL(resolved.Apply(input), (VtIntArray{4,1,2,3,4,9,6}));
+
+    // A write that reads an element a later resize drops still reads it.
+    const VtIntArrayEditPlan readThenShrink(
+        builder.WriteRef(5, 0).SetSize(2).SetSize(4).FinalizeAndReset(), 6);
+    CHECK_EQUAL(readThenShrink.Apply(input), (VtIntArray{5,1,0,0}));
+
+    // Random edits that only write and resize.
+    for (int trial = 0; trial != 100; ++trial) {
+        const size_t inputSize = gen() % 17;
+        for (int i = gen() % 8; i--; ) {
+            const int64_t index = int64_t(gen() % 24) - 8;
+            switch (gen() % 6) {
+            case 0: builder.Write(-i, index); break;
+            case 1: builder.WriteRef(int64_t(gen() % 24) - 8, index); break;
+            case 2: builder.WriteRefRange(gen() % 8, gen() % 8, gen() % 4);
+                break;
+            case 3: builder.SetSize(gen() % 16, 100 + i); break;
+            case 4: builder.MinSize(gen() % 16); break;
+            case 5: builder.MaxSize(gen() % 16); break;
+            }
+        }
+        const VtIntArrayEdit edit = builder.FinalizeAndReset();
+        const VtIntArray input = _MakeIota(inputSize);
+        const VtIntArrayEditPlan plan(edit, inputSize);
+        const VtIntArray expected = edit.ComposeOver(input).GetDenseArray();
+        CHECK_EQUAL(plan.Apply(input), expected);
+        TF_AXIOM(plan.GetOutputSize() == expected.size());
+    }
+
+    // Dense edits produce the dense array.
+    const VtIntArrayEditPlan dense(VtIntArray{4,5}, 6);
+    CHECK_EQUAL(dense.Apply(input), (VtIntArray{4,5}));
+    TF_AXIOM(dense.GetOutputSize() == 2);
+
+    // Apply to many samples at once.
+    const VtIntArrayEditPlan plan(
+        builder.Prepend(-1).EraseRef(-1).Write(9, 3).FinalizeAndReset(), 6);
+    std::vector<VtIntArray> samples;
+    for (int i = 0; i != 100; ++i) {
+        samples.push_back(input + VtIntArray(6, i));
+    }
+    plan.ApplyToEach(samples);
+    for (int i = 0; i != 100; ++i) {
+        CHECK_EQUAL(samples[i], (VtIntArray{-1,i,i+1,9,i+3,i+4}));
+    }
+}
+
+static size_t
+_GetNumLiterals(VtIntArrayEdit const &edit)
+{
+    VtIntArray literals;
+    std::vector<int64_t> indexes;
+    VtIntArrayEditBuilder::GetSerializationData(edit, &literals, &indexes);
+    return literals.size();
+}
+
+static size_t
+_GetNumIndexes(VtIntArrayEdit const &edit)
+{
+    VtIntArray literals;
+    std::vector<int64_t> indexes;
+    VtIntArrayEditBuilder::GetSerializationData(edit, &literals, &indexes);
+    return indexes.size();
+}
+
+static void testBulkBuilder()
+{
+    // Bulk calls must build the same edits as the equivalent single calls.
+    std::mt19937 gen(3579);
+    for (int trial = 0; trial != 20; ++trial) {
+        std::vector<int> elems;
+        std::vector<int64_t> indexes;
+        for (int i = 0, n = gen() % 100; i != n; ++i) {
+            elems.push_back(gen() % 10);
+            indexes.push_back(static_cast<int>(gen() % 200) - 100);
+        }
+
+        VtIntArrayEditBuilder single, bulk;
+        for (size_t i = 0; i != elems.size(); ++i) {
+            single.Write(elems[i], indexes[i]);
+        }
+        for (size_t i = 0; i != elems.size(); ++i) {
+            single.Insert(elems[i], indexes[i]);
+        }
+        for (size_t i = 0; i != elems.size(); ++i) {
+            single.EraseRef(indexes[i]);
+        }
+        bulk.WriteMany(elems, indexes)
+            .InsertMany(elems, indexes)
+            .EraseMany(indexes);
+        TF_AXIOM(single.FinalizeAndReset() == bulk.FinalizeAndReset());
+    }
+
+    // Bulk calls extend runs of the same op, and share literals.
+    VtIntArrayEditBuilder builder;
+    const std::vector<int> elems { 3, 4, 3 };
+    const std::vector<int64_t> indexes { 0, 2, 4 };
+    const VtIntArrayEdit edit =
+        builder.Write(4, 1).WriteMany(elems, indexes).FinalizeAndReset();
+    TF_AXIOM(_GetNumLiterals(edit) == 2);
+    TF_AXIOM(_GetNumIndexes(edit) == 9);
+    CHECK_EQUAL(edit.ComposeOver(VtIntArray(5)).GetDenseArray(),
+                (VtIntArray{3,4,4,0,3}));
+
+    // Mismatched sizes are an error.
+    {
+        TfErrorMark m;
+        builder.WriteMany(elems, TfSpan<const int64_t>(indexes).first(2));
+        TF_AXIOM(!m.IsClean());
+        m.Clear();
+    }
+    TF_AXIOM(builder.FinalizeAndReset().IsIdentity());
+}
+
+static void testMergeBuilders()
+{
+    // Build disjoint writes in parallel, one builder per chunk, with values
+    // shared across chunks, plus ranges that must stay contiguous.
+    const size_t numChunks = 16, chunkSize = 1000;
+    std::vector<VtIntArrayEditBuilder> builders(numChunks);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, numChunks),
+        [&builders](tbb::blocked_range<size_t> const &r) {
+            for (size_t c = r.begin(); c != r.end(); ++c) {
+                const int64_t start = c * chunkSize;
+                for (int64_t i = start; i != start + 500; ++i) {
+                    builders[c].Write(-static_cast<int>(i % 7), i);
+                }
+                builders[c].WriteRange(VtIntArray{-1, -2, -1}, start + 600);
+                builders[c].Write(-1, start + 700);
+            }
+        });
+
+    // The same writes, made in chunk order to one builder.
+    VtIntArrayEditBuilder serial;
+    for (size_t c = 0; c != numChunks; ++c) {
+        const int64_t start = c * chunkSize;
+        for (int64_t i = start; i != start + 500; ++i) {
+            serial.Write(-static_cast<int>(i % 7), i);
+        }
+        serial.WriteRange(VtIntArray{-1, -2, -1}, start + 600);
+        serial.Write(-1, start + 700);
+    }
+    const VtIntArrayEdit expected = serial.FinalizeAndReset();
+
+    const VtIntArrayEdit merged =
+        VtIntArrayEditBuilder::MergeAndReset(builders);
+    TF_AXIOM(_GetNumLiterals(merged) == _GetNumLiterals(expected));
+    TF_AXIOM(_GetNumLiterals(merged) == 7 + 3 * numChunks);
+    const VtIntArray base = _MakeIota(numChunks * chunkSize);
+    CHECK_EQUAL(merged.ComposeOver(base).GetDenseArray(),
+                expected.ComposeOver(base).GetDenseArray());
+    for (VtIntArrayEditBuilder &builder: builders) {
+        TF_AXIOM(builder.FinalizeAndReset().IsIdentity());
+    }
+
+    // Later builders' edits apply after earlier ones'.
+    builders.assign(2, VtIntArrayEditBuilder());
+    builders[0].Write(1, 0).SetSize(4, 5);
+    builders[1].Write(2, 0).Insert(5, 1);
+    CHECK_EQUAL(VtIntArrayEditBuilder::MergeAndReset(builders)
+                .ComposeOver(VtIntArray(2)).GetDenseArray(),
+                (VtIntArray{2,5,0,5,5}));
+    TF_AXIOM(VtIntArrayEditBuilder::MergeAndReset({}).IsIdentity());
+}
+
+static void testComposeOptimization()
+{
+    // Composing stacks of random edits must act like applying each in turn.
+    std::mt19937 gen(5678);
+    for (int trial = 0; trial != 100; ++trial) {
+        const VtIntArray input = _MakeIota(gen() % 65);
+        std::vector<int> expected(input.begin(), input.end());
+        VtIntArrayEdit composed;
+        for (int layer = 0, numLayers = gen() % 6 + 1;
+             layer != numLayers; ++layer) {
+            composed = _MakeRandomEdit(gen, &expected).ComposeOver(composed);
+        }
+        CHECK_EQUAL(composed.ComposeOver(input).GetDenseArray(),
+                    VtIntArray(expected.begin(), expected.end()));
+    }
+
+    // Overwritten stores are dropped, and equal literals are shared, so
+    // composing layers that write the same indexes does not grow the edit.
+    VtIntArrayEditBuilder builder;
+    VtIntArrayEdit layers;
+    for (int layer = 0; layer != 10; ++layer) {
+        const VtIntArrayEdit edit = builder
+            .Write(layer % 2, 0)
+            .Write(layer % 2, 1)
+            .Write(7, -1)
+            .FinalizeAndReset();
+        layers = edit.ComposeOver(layers);
+    }
+    CHECK_EQUAL(layers.ComposeOver(VtIntArray{3,3,3,3}).GetDenseArray(),
+                (VtIntArray{1,1,3,7}));
+    TF_AXIOM(_GetNumLiterals(layers) == 2);
+    TF_AXIOM(_GetNumIndexes(layers) == 7);
+
+    // A ref write reads its source, so a prior write to it must stay.
+    VtIntArrayEdit copyFirst = builder
+        .Write(4, 0)
+        .WriteRef(0, 1)
+        .Write(5, 0)
+        .FinalizeAndReset();
+    CHECK_EQUAL(
+        copyFirst.ComposeOver(VtIntArrayEdit{}).ComposeOver(
+            VtIntArray{1,2}).GetDenseArray(), (VtIntArray{5,4}));
+    CHECK_EQUAL(
+        copyFirst.ComposeOver(copyFirst).ComposeOver(
+            VtIntArray{1,2}).GetDenseArray(), (VtIntArray{5,4}));
+
+    // Consecutive size ops fold together.
+    VtIntArrayEdit sizes = builder.MinSize(10).FinalizeAndReset();
+    sizes = builder.MaxSize(15).FinalizeAndReset().ComposeOver(sizes);
+    sizes = builder.MaxSize(12).FinalizeAndReset().ComposeOver(sizes);
+    sizes = builder.MinSize(4).FinalizeAndReset().ComposeOver(sizes);
+    TF_AXIOM(_GetNumIndexes(sizes) == 4);
+    CHECK_EQUAL(sizes.ComposeOver(VtIntArray(7, 1)).GetDenseArray(),
+                (VtIntArray{1,1,1,1,1,1,1,0,0,0}));
+    CHECK_EQUAL(sizes.ComposeOver(VtIntArray(20, 2)).GetDenseArray(),
+                (VtIntArray(12, 2)));
+
+    // Truncating then growing with a fill cannot fold.
+    VtIntArrayEdit truncGrow = builder.SetSize(5, 9).FinalizeAndReset()
+        .ComposeOver(builder.MaxSize(2).FinalizeAndReset());
+    CHECK_EQUAL(truncGrow.ComposeOver(VtIntArray(4, 1)).GetDenseArray(),
+                (VtIntArray{1,1,9,9,9}));
+}
+
+static void testComposeStack()
+{
+    // Folding a stack must act like composing each edit in turn.
+    std::mt19937 gen(8765);
+    for (int trial = 0; trial != 100; ++trial) {
+        std::vector<VtIntArrayEdit> stack;
+        const size_t depth = gen() % 6;
+        for (size_t i = 0; i != depth; ++i) {
+            const unsigned kind = gen() % 8;
+            if (kind == 0) {
+                stack.push_back(VtIntArrayEdit(_MakeIota(gen() % 8)));
+            }
+            else if (kind == 1) {
+                stack.push_back(VtIntArrayEdit());
+            }
+            else {
+                std::vector<int> unused(gen() % 16);
+                stack.push_back(_MakeRandomEdit(gen, &unused));
+            }
+        }
+
+        VtIntArrayEdit composed;
+        for (size_t i = stack.size(); i--; ) {
+            composed = stack[i].ComposeOver(composed);
+        }
+        const VtIntArrayEdit folded = VtIntArrayEdit::ComposeStack(stack);
+
+        TF_AXIOM(folded.IsDenseArray() == composed.IsDenseArray());
+        if (composed.IsDenseArray()) {
+            CHECK_EQUAL(folded.GetDenseArray(), composed.GetDenseArray());
+        }
+        for (size_t size: { 0, 3, 16 }) {
+            const VtIntArray input = _MakeIota(size);
+            CHECK_EQUAL(folded.ComposeOver(input).GetDenseArray(),
+                        composed.ComposeOver(input).GetDenseArray());
+        }
+    }
+
+    VtIntArrayEditBuilder builder;
+    const VtIntArrayEdit append = builder.Append(7).FinalizeAndReset();
+    const VtIntArrayEdit prepend = builder.Prepend(5).FinalizeAndReset();
+
+    // Empty stacks and stacks of identities are identities.
+    std::vector<VtIntArrayEdit> identities(3);
+    TF_AXIOM(VtIntArrayEdit::ComposeStack({}).IsIdentity());
+    TF_AXIOM(VtIntArrayEdit::ComposeStack(identities).IsIdentity());
+
+    // Edits weaker than a dense array have no effect.
+    std::vector<VtIntArrayEdit> stack {
+        append, VtIntArrayEdit(), prepend, VtIntArrayEdit(VtIntArray{1,2}),
+        append, VtIntArrayEdit(VtIntArray{3})
+    };
+    CHECK_EQUAL(VtIntArrayEdit::ComposeStack(stack).GetDenseArray(),
+                (VtIntArray{5,1,2,7}));
+    CHECK_EQUAL(VtIntArrayEdit::ComposeStack(
+                    TfSpan<const VtIntArrayEdit>(stack).subspan(3))
+                .GetDenseArray(), (VtIntArray{1,2}));
+
+    // Without a dense array the result is still an edit.
+    stack = { append, prepend, append };
+    const VtIntArrayEdit folded = VtIntArrayEdit::ComposeStack(stack);
+    TF_AXIOM(!folded.IsDenseArray());
+    CHECK_EQUAL(folded.ComposeOver(VtIntArray{0}).GetDenseArray(),
+                (VtIntArray{5,0,7,7}));
+}
+
+static void testCompactSerialization()
+{
+    VtIntArray literals;
+    std::vector<int64_t> indexes;
+    std::vector<uint8_t> bytes;
+
+    // Compact serialization data must reproduce the same edit.
+    std::mt19937 gen(2468);
+    for (int trial = 0; trial != 100; ++trial) {
+        std::vector<int> unused(gen() % 65);
+        const VtIntArrayEdit edit = _MakeRandomEdit(gen, &unused);
+        VtIntArrayEditBuilder::GetCompactSerializationData(
+            edit, &literals, &bytes);
+        TF_AXIOM(edit ==
+                 VtIntArrayEditBuilder::CreateFromCompactSerializationData(
+                     literals, bytes, edit.IsDenseArray()));
+    }
+
+    const VtIntArray dense { 1, 2, 3 };
+    VtIntArrayEditBuilder::GetCompactSerializationData(
+        VtIntArrayEdit(dense), &literals, &bytes);
+    const VtIntArrayEdit denseEdit =
+        VtIntArrayEditBuilder::CreateFromCompactSerializationData(
+            literals, bytes, true);
+    TF_AXIOM(denseEdit.IsDenseArray());
+    CHECK_EQUAL(denseEdit.GetDenseArray(), dense);
+
+    // Sequential indexes take a byte each.
+    VtIntArrayEditBuilder builder;
+    for (int i = 0; i != 100; ++i) {
+        builder.Write(i, 1000 + i);
+    }
+    builder.Append(-1);
+    const VtIntArrayEdit edit = builder.FinalizeAndReset();
+    VtIntArrayEditBuilder::GetSerializationData(edit, &literals, &indexes);
+    VtIntArrayEditBuilder::GetCompactSerializationData(
+        edit, &literals, &bytes);
+    TF_AXIOM(bytes.size() < indexes.size() + 16);
+    TF_AXIOM(bytes.size() * 4 < indexes.size() * sizeof(int64_t));
+
+    // Truncated or corrupt data is an error, and produces the identity.
+    for (size_t size = 0; size != bytes.size(); ++size) {
+        TfErrorMark m;
+        TF_AXIOM(VtIntArrayEditBuilder::CreateFromCompactSerializationData(
+                     literals, TfSpan<const uint8_t>(bytes.data(), size),
+                     false).IsIdentity());
+        TF_AXIOM(!m.IsClean());
+        m.Clear();
+    }
+    std::vector<uint8_t> corrupt = bytes;
+    corrupt[1] = 0xff; // op code out of range
+    {
+        TfErrorMark m;
+        TF_AXIOM(VtIntArrayEditBuilder::CreateFromCompactSerializationData(
+                     literals, corrupt, false).IsIdentity());
+        TF_AXIOM(!m.IsClean());
+        m.Clear();
+    }
+}
+
+static void testDiff()
+{
+    // Diffs must reproduce the new array when composed over the old.
+    std::mt19937 gen(1357);
+    for (int trial = 0; trial != 200; ++trial) {
+        const VtIntArray oldArray = _MakeIota(gen() % 100);
+        std::vector<int> newElems(oldArray.begin(), oldArray.end());
+        for (int i = 0, n = gen() % 8; i != n; ++i) {
+            const size_t index = gen() % (newElems.size() + 1);
+            switch (gen() % 3) {
+            case 0:
+                newElems.insert(newElems.begin() + index, -i - 1);
+                break;
+            case 1:
+                if (index != newElems.size()) {
+                    newElems.erase(newElems.begin() + index);
+                }
+                break;
+            case 2:
+                if (index != newElems.size()) {
+                    newElems[index] = -i - 1;
+                }
+                break;
+            }
+        }
+        const VtIntArray newArray(newElems.begin(), newElems.end());
+        const VtIntArrayEdit diff =
+            VtIntArrayEditBuilder::Diff(oldArray, newArray);
+        CHECK_EQUAL(diff.ComposeOver(oldArray).GetDenseArray(), newArray);
+        TF_AXIOM(VtIntArrayEditBuilder::Diff(oldArray, oldArray).IsIdentity());
+    }
+
+    const VtIntArray oldArray = _MakeIota(100);
+    VtIntArray newArray = oldArray;
+
+    // Equal arrays need no edit.
+    newArray[50] = 50;
+    TF_AXIOM(VtIntArrayEditBuilder::Diff(oldArray, newArray).IsIdentity());
+
+    // Same-size arrays get writes.
+    newArray[10] = -1;
+    newArray[20] = -2;
+    newArray[21] = -3;
+    VtIntArrayEdit diff = VtIntArrayEditBuilder::Diff(oldArray, newArray);
+    TF_AXIOM(!diff.IsDenseArray());
+    TF_AXIOM(_GetNumLiterals(diff) == 3);
+    CHECK_EQUAL(diff.ComposeOver(oldArray).GetDenseArray(), newArray);
+
+    // Inserts and erases carry only the inserted elements.
+    newArray = oldArray;
+    newArray.erase(newArray.begin() + 80, newArray.begin() + 90);
+    newArray.insert(newArray.begin() + 40, -1);
+    newArray.erase(newArray.begin());
+    diff = VtIntArrayEditBuilder::Diff(oldArray, newArray);
+    TF_AXIOM(!diff.IsDenseArray());
+    TF_AXIOM(_GetNumLiterals(diff) == 1);
+    CHECK_EQUAL(diff.ComposeOver(oldArray).GetDenseArray(), newArray);
+
+    // Too many changes, or unrelated arrays, produce dense edits.
+    diff = VtIntArrayEditBuilder::Diff(oldArray, newArray, 5);
+    TF_AXIOM(diff.IsDenseArray());
+    CHECK_EQUAL(diff.GetDenseArray(), newArray);
+    newArray = VtIntArray(120, -1);
+    diff = VtIntArrayEditBuilder::Diff(oldArray, newArray);
+    TF_AXIOM(diff.IsDenseArray());
+    CHECK_EQUAL(diff.GetDenseArray(), newArray);
+    diff = VtIntArrayEditBuilder::Diff(oldArray, VtIntArray());
+    CHECK_EQUAL(diff.ComposeOver(oldArray).GetDenseArray(), VtIntArray());
+}
+
+static void testView()
+{
+    // Views must read the same elements as ComposeOver() produces.
+    std::mt19937 gen(9753);
+    for (int trial = 0; trial != 100; ++trial) {
+        const VtIntArray base = _MakeIota(gen() % 65);
+        std::vector<int> unused(base.size());
+        const VtIntArrayEdit edit = _MakeRandomEdit(gen, &unused);
+        const VtIntArray expected = edit.ComposeOver(base).GetDenseArray();
+        const VtIntArrayEditView view(edit, base);
+        TF_AXIOM(view.size() == expected.size());
+        for (size_t i = 0; i != view.size(); ++i) {
+            TF_AXIOM(view[i] == expected[i]);
+        }
+        CHECK_EQUAL(view.GetDenseArray(), expected);
+    }
+
+    VtIntArrayEditBuilder builder;
+    const VtIntArray base = _MakeIota(1000000);
+
+    // Read a few elements of a large edited array.
+    const VtIntArrayEditView view(
+        builder.Prepend(-1).EraseRef(500000).MinSize(1000002, 7)
+        .FinalizeAndReset(), base);
+    TF_AXIOM(view.size() == 1000002);
+    TF_AXIOM(view[0] == -1 && view[1] == 0);
+    TF_AXIOM(view[499999] == 499998 && view[500000] == 500000);
+    TF_AXIOM(view[999999] == 999999 && view[1000000] == 7);
+
+    // Unchanged arrays share the base's data.
+    const VtIntArrayEditView noop(VtIntArrayEdit(), base);
+    TF_AXIOM(noop.GetDenseArray().IsIdentical(base));
+    TF_AXIOM(VtIntArrayEditView().empty());
+
+    // Dense edits ignore the base.
+    const VtIntArrayEditView dense(VtIntArray{4,5}, base);
+    TF_AXIOM(dense.size() == 2 && dense[1] == 5);
+}
+
+static void testInverse()
+{
+    // Inverses must restore the input when composed over the result.
+    std::mt19937 gen(8642);
+    for (int trial = 0; trial != 200; ++trial) {
+        const VtIntArray base = _MakeIota(gen() % 65);
+        std::vector<int> unused(base.size());
+        const VtIntArrayEdit edit = _MakeRandomEdit(gen, &unused);
+        VtIntArrayEdit inverse;
+        const VtIntArray result = edit.ApplyWithInverse(base, &inverse);
+        CHECK_EQUAL(result, edit.ComposeOver(base).GetDenseArray());
+        CHECK_EQUAL(inverse.ComposeOver(result).GetDenseArray(), base);
+    }
+
+    VtIntArrayEditBuilder builder;
+    const VtIntArray base = _MakeIota(1000000);
+    VtIntArrayEdit inverse;
+
+    // Inverses only hold the overwritten and erased elements.
+    VtIntArray result = builder
+        .Write(-1, 10).Write(-2, 10).WriteRange(VtIntArray{-3, -4}, -2)
+        .FinalizeAndReset().ApplyWithInverse(base, &inverse);
+    TF_AXIOM(result[10] == -2 && result[999999] == -4);
+    TF_AXIOM(_GetNumLiterals(inverse) == 3);
+    CHECK_EQUAL(inverse.ComposeOver(result).GetDenseArray(), base);
+
+    result = builder
+        .Prepend(-1).EraseRange(500000, 3).Write(-2, 700000).Append(-3)
+        .FinalizeAndReset().ApplyWithInverse(base, &inverse);
+    TF_AXIOM(result.size() == 999999);
+    TF_AXIOM(_GetNumLiterals(inverse) == 4);
+    CHECK_EQUAL(inverse.ComposeOver(result).GetDenseArray(), base);
+
+    // Shrinking drops the elements past the new size.
+    result = builder.SetSize(999990).MinSize(1000005, 7).FinalizeAndReset()
+        .ApplyWithInverse(base, &inverse);
+    TF_AXIOM(result.size() == 1000005 && result[999995] == 7);
+    TF_AXIOM(_GetNumLiterals(inverse) == 10);
+    CHECK_EQUAL(inverse.ComposeOver(result).GetDenseArray(), base);
+
+    // The inverse of an identity edit is the identity, and the inverse of a
+    // dense array is the input.
+    VtIntArrayEdit().ApplyWithInverse(base, &inverse);
+    TF_AXIOM(inverse.IsIdentity());
+    VtIntArrayEdit(VtIntArray{1, 2}).ApplyWithInverse(base, &inverse);
+    TF_AXIOM(inverse.IsDenseArray());
+    TF_AXIOM(inverse.GetDenseArray().IsIdentical(base));
+
+    // An edit may be its own inverse's destination.
+    VtIntArrayEdit edit = builder.Write(-1, 0).FinalizeAndReset();
+    result = edit.ApplyWithInverse(base, &edit);
+    CHECK_EQUAL(edit.ComposeOver(result).GetDenseArray(), base);
+}
+
 int main(int argc, char *argv[])
 {
     testBasics();
     testBuilderAndComposition();
+    testApplyInsertErase();
+    testRanges();
+    testBulkBuilder();
+    testMergeBuilders();
+    testParallelWrites();
+    testPlan();
+    testView();
+    testComposeOptimization();
+    testComposeStack();
+    testCompactSerialization();
+    testDiff();
+    testInverse();
 
     printf("Test SUCCEEDED\n");
 
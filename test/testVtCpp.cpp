@@ -57,6 +57,7 @@
 #include <pxr/arch/fileSystem.h>
 #include <pxr/arch/pragmas.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <iterator>
@@ -1037,6 +1038,17 @@ bool operator==(const _NotStreamable &l, const _NotStreamable &r)
     return true;
 }
 
+// A type that is not known to Vt, with casts to and from double.
+struct _CastTestNumber
+{
+    explicit _CastTestNumber(double x) : x(x) {}
+    explicit operator double() const { return x; }
+    bool operator==(_CastTestNumber const &other) const {
+        return x == other.x;
+    }
+    double x;
+};
+
 struct _NotDefaultConstructible
 {
     explicit _NotDefaultConstructible(int x) {}
@@ -1192,6 +1204,121 @@ static void testValue() {
     if (v.CanCastToTypeid(typeid(GfVec3d)))
         die("CanCast double to typeid of GfVec3d");
 
+    // Casts registered after startup, between known types and to and from a
+    // type that is not known to Vt.
+    {
+        TF_AXIOM(!VtValue(GfVec2i(1, 2)).CanCast<GfVec3i>());
+        VtValue::RegisterCast<GfVec2i, GfVec3i>([](VtValue const &val) {
+            GfVec2i const &vec = val.UncheckedGet<GfVec2i>();
+            return VtValue(GfVec3i(vec[0], vec[1], 0));
+        });
+        v = VtValue(GfVec2i(1, 2));
+        TF_AXIOM(v.CanCast<GfVec3i>());
+        TF_AXIOM(v.CanCastToTypeOf(VtValue(GfVec3i())));
+        TF_AXIOM(v.CanCastToTypeid(typeid(GfVec3i)));
+        TF_AXIOM(VtValue::Cast<GfVec3i>(v) == GfVec3i(1, 2, 0));
+        TF_AXIOM(VtValue::CastToTypeOf(v, VtValue(GfVec3i())) ==
+                 GfVec3i(1, 2, 0));
+        TF_AXIOM(VtValue::CastToTypeid(v, typeid(GfVec3i)) ==
+                 GfVec3i(1, 2, 0));
+
+        VtValue::RegisterSimpleBidirectionalCast<_CastTestNumber, double>();
+        v = VtValue(_CastTestNumber(2.5));
+        TF_AXIOM(v.CanCast<double>());
+        TF_AXIOM(VtValue::Cast<double>(v) == 2.5);
+        TF_AXIOM(!v.CanCast<float>());
+        TF_AXIOM(VtValue::Cast<float>(v).IsEmpty());
+        v = VtValue(0.5);
+        TF_AXIOM(v.CanCast<_CastTestNumber>());
+        TF_AXIOM(VtValue::Cast<_CastTestNumber>(v) == _CastTestNumber(0.5));
+
+        // Built-in casts cannot be registered again.
+        TfErrorMark m;
+        VtValue::RegisterCast<int, double>([](VtValue const &) {
+            return VtValue(-1.0);
+        });
+        TF_AXIOM(!m.IsClean());
+        m.Clear();
+        TF_AXIOM(VtValue::Cast<double>(VtValue(3)) == 3.0);
+        TF_AXIOM(VtValue::CastToTypeid(VtValue(3), typeid(double)) == 3.0);
+        TF_AXIOM(VtValue::CastToTypeid(VtValue(3ll), typeid(signed char)) ==
+                 static_cast<signed char>(3));
+    }
+
+    // Transitive casts.
+    {
+        TF_AXIOM(!VtValue::GetTransitiveCastsEnabled());
+        v = VtValue(_CastTestNumber(2.5));
+        TF_AXIOM(!v.CanCast<float>());
+
+        VtValue::SetTransitiveCastsEnabled(true);
+        TF_AXIOM(VtValue::GetTransitiveCastsEnabled());
+        TF_AXIOM(v.CanCast<float>());
+        TF_AXIOM(v.CanCastToTypeid(typeid(float)));
+        TF_AXIOM(VtValue::Cast<float>(v) == 2.5f);
+        TF_AXIOM(VtValue::CastToTypeid(v, typeid(float)) == 2.5f);
+        TF_AXIOM(VtValue::Cast<GfVec3d>(VtValue(GfVec2i(1, 2))) ==
+                 GfVec3d(1, 2, 0));
+
+        // The chain fails if any cast in it fails.
+        v = VtValue(_CastTestNumber(1e50));
+        TF_AXIOM(v.CanCast<short>());
+        TF_AXIOM(VtValue::Cast<short>(v).IsEmpty());
+        TF_AXIOM(!v.CanCast<GfMatrix4d>());
+        TF_AXIOM(VtValue::Cast<GfMatrix4d>(v).IsEmpty());
+
+        // Registering a cast can connect types that were not.
+        v = VtValue(1.5);
+        TF_AXIOM(!v.CanCast<TfToken>());
+        VtValue::RegisterCast<_CastTestNumber, std::string>(
+            [](VtValue const &val) {
+                return VtValue(TfStringify(
+                    static_cast<double>(val.UncheckedGet<_CastTestNumber>())));
+            });
+        TF_AXIOM(v.CanCast<TfToken>());
+        TF_AXIOM(VtValue::Cast<TfToken>(v) == TfToken("1.5"));
+
+        VtValue::SetTransitiveCastsEnabled(false);
+        TF_AXIOM(!v.CanCast<TfToken>());
+    }
+
+    // Batch casts.
+    {
+        std::vector<VtValue> values {
+            VtValue(1), VtValue(2.5), VtValue(), VtValue(std::string("x")),
+            VtValue(3), VtValue(GfVec3f(1.0f)), VtValue(4u),
+            VtValue(_CastTestNumber(5.5)) };
+        std::vector<VtValue> result(values.size());
+        VtValue::CastBatch(values, typeid(double), result);
+        TF_AXIOM(result[0] == 1.0);
+        TF_AXIOM(result[1] == 2.5);
+        TF_AXIOM(result[2].IsEmpty());
+        TF_AXIOM(result[3].IsEmpty());
+        TF_AXIOM(result[4] == 3.0);
+        TF_AXIOM(result[5].IsEmpty());
+        TF_AXIOM(result[6] == 4.0);
+        TF_AXIOM(result[7] == 5.5);
+
+        // Cast in place, with enough values of one type to run in parallel.
+        values.assign(10000, VtValue(1.5f));
+        values[5000] = VtValue(GfVec3i(1));
+        VtValue::CastBatch(values, typeid(GfVec3d), values);
+        TF_AXIOM(values[0].IsEmpty());
+        TF_AXIOM(values[5000] == GfVec3d(1.0));
+        VtValue::CastBatch(values, typeid(GfVec3d), values);
+        TF_AXIOM(values[5000] == GfVec3d(1.0));
+
+        values.assign(10000, VtValue(2));
+        VtValue::CastBatch(values, typeid(float), values);
+        TF_AXIOM(std::all_of(values.begin(), values.end(),
+                             [](VtValue const &val) { return val == 2.0f; }));
+
+        TfErrorMark m;
+        VtValue::CastBatch(values, typeid(double), result);
+        TF_AXIOM(!m.IsClean());
+        m.Clear();
+    }
+
     // Check that too large doubles cast to float infinities
     v = VtValue(1e50);
     if (!v.CanCast<float>())
@@ -1508,6 +1635,46 @@ static void testValue() {
         TF_AXIOM(b.Get<VtDictionary>().count("foo"));
     }
 
+    // Test that VtValues holding arrays share the arrays' data, and that
+    // mutating a held array detaches it from the others.
+    {
+        static_assert(std::is_nothrow_move_constructible<VtIntArray>::value,
+                      "");
+        static_assert(std::is_nothrow_move_assignable<VtIntArray>::value, "");
+
+        const VtIntArray array({1, 2, 3});
+        VtValue v(array);
+
+        // Arrays are held in place only if local storage fits them, as it
+        // does with VT_VALUE_LOCAL_STORAGE_SIZE set to 40 on 64-bit builds.
+        const char *held =
+            reinterpret_cast<const char *>(&v.UncheckedGet<VtIntArray>());
+        const bool isHeldLocally =
+            held >= reinterpret_cast<const char *>(&v) &&
+            held < reinterpret_cast<const char *>(&v + 1);
+        TF_AXIOM(isHeldLocally ==
+                 (sizeof(VtIntArray) <= std::max<size_t>(
+                     VT_VALUE_LOCAL_STORAGE_SIZE, sizeof(void *))));
+
+        VtValue copy = v;
+        TF_AXIOM(v.UncheckedGet<VtIntArray>().IsIdentical(array));
+        TF_AXIOM(copy.UncheckedGet<VtIntArray>().IsIdentical(array));
+
+        TF_AXIOM(copy.Mutate<VtIntArray>([](VtIntArray &a) { a[0] = 4; }));
+        TF_AXIOM(copy.UncheckedGet<VtIntArray>() == VtIntArray({4, 2, 3}));
+        TF_AXIOM(v.UncheckedGet<VtIntArray>().IsIdentical(array));
+        TF_AXIOM(array == VtIntArray({1, 2, 3}));
+
+        VtIntArray taken = array;
+        VtValue moved = VtValue::Take(taken);
+        TF_AXIOM(taken.empty());
+        TF_AXIOM(moved.UncheckedGet<VtIntArray>().IsIdentical(array));
+
+        v.Swap(copy);
+        TF_AXIOM(v.UncheckedGet<VtIntArray>() == VtIntArray({4, 2, 3}));
+        TF_AXIOM(copy.UncheckedGet<VtIntArray>().IsIdentical(array));
+    }
+
     // Test creating VtValues by taking contents of objects, and destructively
     // removing contents from objects.
     {
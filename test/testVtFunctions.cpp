@@ -0,0 +1,595 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/vt/pxr.h>
+#include <pxr/vt/array.h>
+#include <pxr/vt/functions.h>
+#include <pxr/vt/types.h>
+
+#include <pxr/gf/dualQuatf.h>
+#include <pxr/gf/matrix4d.h>
+#include <pxr/gf/quatd.h>
+#include <pxr/gf/quatf.h>
+#include <pxr/gf/range1d.h>
+#include <pxr/gf/range1f.h>
+#include <pxr/gf/range3f.h>
+#include <pxr/gf/vec3d.h>
+#include <pxr/gf/vec3f.h>
+#include <pxr/gf/vec3i.h>
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+VT_NAMESPACE_USING_DIRECTIVE
+
+// Large enough to take the parallel code paths.
+static const size_t LargeSize = 1000003;
+
+static void testSum()
+{
+    TF_AXIOM(VtArraySum(VtIntArray()) == 0);
+    TF_AXIOM(VtArraySum(VtIntArray { 1, 2, 3, 4, 5 }) == 15);
+    TF_AXIOM(VtArraySum(VtDoubleArray { 0.5, 0.25, 0.25 }) == 1.0);
+    TF_AXIOM(VtArraySum(VtVec3iArray { GfVec3i(1, 2, 3), GfVec3i(4, 5, 6) })
+             == GfVec3i(5, 7, 9));
+    TF_AXIOM(VtArraySum(VtVec3fArray()) == GfVec3f(0));
+
+    // Sizes that don't fill a whole set of lanes.
+    for (size_t n = 1; n != 40; ++n) {
+        VtInt64Array ints(n);
+        for (size_t i = 0; i != n; ++i) {
+            ints[i] = i + 1;
+        }
+        TF_AXIOM(VtArraySum(ints) == static_cast<int64_t>(n * (n + 1) / 2));
+    }
+
+    VtInt64Array ints(LargeSize);
+    VtVec3dArray points(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        ints[i] = i;
+        points[i] = GfVec3d(1.0, 2.0, i % 2);
+    }
+    TF_AXIOM(VtArraySum(ints) ==
+             static_cast<int64_t>(LargeSize * (LargeSize - 1) / 2));
+    TF_AXIOM(VtArraySum(points) ==
+             GfVec3d(LargeSize, 2.0 * LargeSize, LargeSize / 2));
+
+    // Deterministic sums must be bitwise reproducible.
+    VtFloatArray floats(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        floats[i] = 1.0f / (1 + (i % 1013));
+    }
+    const float first = VtArraySum(floats, /*deterministic=*/true);
+    for (int i = 0; i != 10; ++i) {
+        const float again = VtArraySum(floats, /*deterministic=*/true);
+        TF_AXIOM(memcmp(&first, &again, sizeof(float)) == 0);
+    }
+}
+
+static void testDot()
+{
+    TF_AXIOM(VtArrayDot(VtIntArray(), VtIntArray()) == 0);
+    TF_AXIOM(VtArrayDot(VtIntArray { 1, 2, 3 }, VtIntArray { 4, 5, 6 }) == 32);
+    TF_AXIOM(VtArrayDot(VtVec2dArray { GfVec2d(1, 2), GfVec2d(3, 4) },
+                        VtVec2dArray { GfVec2d(5, 6), GfVec2d(7, 8) }) ==
+             5.0 + 12.0 + 21.0 + 32.0);
+
+    VtDoubleArray ones(LargeSize, 1.0), twos(LargeSize, 2.0);
+    TF_AXIOM(VtArrayDot(ones, twos) == 2.0 * LargeSize);
+    TF_AXIOM(VtArrayDot(ones, twos, /*deterministic=*/true) ==
+             2.0 * LargeSize);
+
+    TfErrorMark mark;
+    TF_AXIOM(VtArrayDot(ones, VtDoubleArray(3)) == 0.0);
+    TF_AXIOM(!mark.IsClean());
+    mark.Clear();
+}
+
+static void testMinMax()
+{
+    int imin = 123, imax = 456;
+    TF_AXIOM(!VtArrayMinMax(VtIntArray(), &imin, &imax));
+    TF_AXIOM(imin == 123 && imax == 456);
+
+    TF_AXIOM(VtArrayMinMax(VtIntArray { 3, -7, 12, 0 }, &imin, &imax));
+    TF_AXIOM(imin == -7 && imax == 12);
+
+    VtDoubleArray doubles(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        doubles[i] = (i * 7919) % LargeSize;
+    }
+    doubles[LargeSize / 3] = -5.0;
+    doubles[LargeSize - 1] = 1e9;
+    double dmin, dmax;
+    TF_AXIOM(VtArrayMinMax(doubles, &dmin, &dmax));
+    TF_AXIOM(dmin == -5.0 && dmax == 1e9);
+
+    // Only one of the outputs is required.
+    TF_AXIOM(VtArrayMinMax(doubles, nullptr, &dmax));
+    TF_AXIOM(dmax == 1e9);
+}
+
+static void testExtent()
+{
+    TF_AXIOM(VtArrayExtent(VtVec3fArray()).IsEmpty());
+
+    const VtVec3fArray points = {
+        GfVec3f(1, 5, -2), GfVec3f(-3, 2, 4), GfVec3f(0, 0, 0)
+    };
+    TF_AXIOM(VtArrayExtent(points) ==
+             GfRange3f(GfVec3f(-3, 0, -2), GfVec3f(1, 5, 4)));
+
+    VtVec3fArray many(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        const float t = static_cast<float>(i) / LargeSize;
+        many[i] = GfVec3f(t, -t, 0.5f);
+    }
+    many[LargeSize / 2] = GfVec3f(-1.0f, 7.0f, 0.5f);
+    const GfRange3f extent = VtArrayExtent(many);
+    TF_AXIOM(extent.GetMin() == GfVec3f(-1.0f, many.back()[1], 0.5f));
+    TF_AXIOM(extent.GetMax() == GfVec3f(many.back()[0], 7.0f, 0.5f));
+
+    TF_AXIOM(VtArrayExtent(VtDoubleArray { 2.0, -1.0 }) ==
+             GfRange1d(-1.0, 2.0));
+}
+
+template <class V>
+static bool _IsClose(V const &a, V const &b, double eps)
+{
+    for (size_t i = 0; i != 3; ++i) {
+        if (std::fabs(double(a[i]) - double(b[i])) > eps) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Row-vector transform of (v, w) by m, divided by the resulting w if nonzero.
+static GfVec3d _RefTransform(GfMatrix4d const &m, GfVec3d const &v, double w)
+{
+    double r[4];
+    for (int j = 0; j != 4; ++j) {
+        r[j] = v[0] * m[0][j] + v[1] * m[1][j] + v[2] * m[2][j] + w * m[3][j];
+    }
+    const double inv = (w != 0.0 && r[3] != 0.0) ? 1.0 / r[3] : 1.0;
+    return GfVec3d(r[0] * inv, r[1] * inv, r[2] * inv);
+}
+
+static void testTransform()
+{
+    GfMatrix4d m(1.0);
+    m[0][0] = 2.0; m[0][1] = 0.5;
+    m[1][1] = 3.0; m[1][2] = -1.0;
+    m[2][0] = 0.25; m[2][2] = 0.5;
+    m[3][0] = 1.0; m[3][1] = 2.0; m[3][2] = 3.0;
+
+    VtVec3dArray points(LargeSize);
+    VtVec3fArray fpoints(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        points[i] = GfVec3d(i % 17, -double(i % 5), 0.125 * (i % 11));
+        fpoints[i] = GfVec3f(points[i]);
+    }
+
+    // Points, directions and normals by one matrix.
+    {
+        const VtVec3dArray xp = VtArrayTransformPoints(points, m);
+        const VtVec3dArray xd = VtArrayTransformDirections(points, m);
+        TF_AXIOM(xp.size() == LargeSize && xd.size() == LargeSize);
+        for (size_t i = 0; i < LargeSize; i += 997) {
+            TF_AXIOM(_IsClose(xp[i], _RefTransform(m, points[i], 1.0), 1e-9));
+            TF_AXIOM(_IsClose(xd[i], _RefTransform(m, points[i], 0.0), 1e-9));
+        }
+
+        const VtVec3fArray xpf = VtArrayTransformPoints(fpoints, m);
+        const VtVec3fArray xpff = VtArrayTransformPoints(
+            fpoints, m, /*accumulateInDouble=*/false);
+        for (size_t i = 0; i < LargeSize; i += 997) {
+            const GfVec3d ref = _RefTransform(m, points[i], 1.0);
+            TF_AXIOM(_IsClose(xpf[i], GfVec3f(ref), 1e-6));
+            TF_AXIOM(_IsClose(xpff[i], GfVec3f(ref), 1e-4));
+        }
+
+        // Transformed normals stay perpendicular to transformed tangents.
+        const VtVec3dArray tangents = { GfVec3d(1, 0, 0), GfVec3d(1, 1, 0) };
+        const VtVec3dArray normals = { GfVec3d(0, 1, 0), GfVec3d(1, -1, 3) };
+        const VtVec3dArray xt = VtArrayTransformDirections(tangents, m);
+        const VtVec3dArray xn = VtArrayTransformNormals(normals, m);
+        for (size_t i = 0; i != tangents.size(); ++i) {
+            TF_AXIOM(std::fabs(GfDot(xt[i], xn[i])) < 1e-12);
+        }
+    }
+
+    // Projective matrices divide by w.
+    {
+        GfMatrix4d p(1.0);
+        p[2][3] = 0.5;
+        const VtVec3dArray in = { GfVec3d(2, 4, 2), GfVec3d(1, 1, -2) };
+        const VtVec3dArray out = VtArrayTransformPoints(in, p);
+        TF_AXIOM(_IsClose(out[0], GfVec3d(1, 2, 1), 1e-12));
+        // w == 0 is left unscaled.
+        TF_AXIOM(_IsClose(out[1], GfVec3d(1, 1, -2), 1e-12));
+    }
+
+    // One matrix per element.
+    {
+        VtMatrix4dArray mats(LargeSize);
+        for (size_t i = 0; i != LargeSize; ++i) {
+            mats[i] = m;
+            mats[i][3][0] = double(i);
+        }
+        const VtVec3dArray xp = VtArrayTransformPoints(points, mats);
+        const VtVec3dArray xd = VtArrayTransformDirections(points, mats);
+        const VtVec3fArray xn = VtArrayTransformNormals(fpoints, mats);
+        const VtVec3fArray xn1 = VtArrayTransformNormals(fpoints, m);
+        for (size_t i = 0; i < LargeSize; i += 997) {
+            TF_AXIOM(_IsClose(xp[i], _RefTransform(mats[i], points[i], 1.0),
+                              1e-9));
+            TF_AXIOM(_IsClose(xd[i], _RefTransform(m, points[i], 0.0), 1e-9));
+            // Normals ignore translation.
+            TF_AXIOM(xn[i] == xn1[i]);
+        }
+
+        // Mismatched sizes are an error.
+        TfErrorMark mark;
+        TF_AXIOM(VtArrayTransformPoints(points, VtMatrix4dArray(3)).empty());
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+}
+
+template <class Q>
+static bool _IsCloseQuat(Q const &a, Q const &b, double eps)
+{
+    return std::fabs(double(a.GetReal()) - double(b.GetReal())) <= eps &&
+        _IsClose(a.GetImaginary(), b.GetImaginary(), eps);
+}
+
+static void testQuaternions()
+{
+    const double s = std::sqrt(0.5);
+    const GfQuatd id(1, 0, 0, 0), qi(0, 1, 0, 0), qj(0, 0, 1, 0);
+    const GfQuatd qk(0, 0, 0, 1), rotZ90(s, 0, 0, s);
+
+    // Normalize.
+    {
+        const VtQuatdArray n = VtArrayQuatNormalize(
+            VtQuatdArray { GfQuatd(2, 0, 0, 0), GfQuatd(0, 3, 0, 4),
+                           GfQuatd(0, 0, 0, 0) });
+        TF_AXIOM(_IsCloseQuat(n[0], id, 1e-12));
+        TF_AXIOM(_IsCloseQuat(n[1], GfQuatd(0, 0.6, 0, 0.8), 1e-12));
+        // Zero quaternions normalize to the identity.
+        TF_AXIOM(_IsCloseQuat(n[2], id, 1e-12));
+    }
+
+    // Multiply.
+    {
+        const VtQuatdArray p = VtArrayQuatMultiply(
+            VtQuatdArray { qi, qj, qk, rotZ90 },
+            VtQuatdArray { qj, qk, qi, rotZ90 });
+        TF_AXIOM(_IsCloseQuat(p[0], qk, 1e-12));
+        TF_AXIOM(_IsCloseQuat(p[1], qi, 1e-12));
+        TF_AXIOM(_IsCloseQuat(p[2], qj, 1e-12));
+        TF_AXIOM(_IsCloseQuat(p[3], GfQuatd(0, 0, 0, 1), 1e-12));
+
+        TfErrorMark mark;
+        TF_AXIOM(VtArrayQuatMultiply(VtQuatdArray(2), VtQuatdArray(3))
+                 .empty());
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+
+    // Slerp.
+    {
+        const double c = std::cos(M_PI / 8), sn = std::sin(M_PI / 8);
+        const VtQuatdArray q = VtArrayQuatSlerp(
+            0.5, VtQuatdArray { id, id, rotZ90 },
+            VtQuatdArray { rotZ90, -1.0 * rotZ90, rotZ90 });
+        TF_AXIOM(_IsCloseQuat(q[0], GfQuatd(c, 0, 0, sn), 1e-12));
+        // Takes the shorter path.
+        TF_AXIOM(_IsCloseQuat(q[1], GfQuatd(c, 0, 0, sn), 1e-12));
+        TF_AXIOM(_IsCloseQuat(q[2], rotZ90, 1e-12));
+    }
+
+    // Rotate, including by non-unit quaternions.
+    {
+        const VtQuatfArray quats = {
+            GfQuatf(rotZ90), GfQuatf(2.0f * GfQuatf(rotZ90)),
+            GfQuatf(0, 0, 0, 0)
+        };
+        const VtVec3fArray v = VtArrayQuatRotate(
+            quats, VtVec3fArray(3, GfVec3f(1, 0, 2)));
+        TF_AXIOM(_IsClose(v[0], GfVec3f(0, 1, 2), 1e-6));
+        TF_AXIOM(_IsClose(v[1], GfVec3f(0, 1, 2), 1e-6));
+        TF_AXIOM(v[2] == GfVec3f(1, 0, 2));
+
+        VtQuatdArray many(LargeSize, GfQuatd(0.5, 0.5, 0.5, 0.5));
+        const VtVec3dArray r = VtArrayQuatRotate(
+            many, VtVec3dArray(LargeSize, GfVec3d(1, 0, 0)));
+        for (size_t i = 0; i < LargeSize; i += 997) {
+            TF_AXIOM(_IsClose(r[i], GfVec3d(0, 1, 0), 1e-12));
+        }
+    }
+
+    // Dual quaternion blending.
+    {
+        const GfQuatf zero(0, 0, 0, 0);
+        const GfDualQuatf a(GfQuatf(1, 0, 0, 0), GfQuatf(0, 1, 0, 0));
+        const GfDualQuatf b(GfQuatf(-1, 0, 0, 0), GfQuatf(0, -3, 0, 0));
+        const VtDualQuatfArray dqs = { a, b };
+
+        const VtDualQuatfArray blended = VtArrayDualQuatBlend(
+            dqs, VtIntArray { 0, 1, 0, 0, 1, 1 },
+            VtFloatArray { 0.5f, 0.5f, 0.25f, 0.75f, 1.0f, 0.0f }, 2);
+        TF_AXIOM(blended.size() == 3);
+        // b is antipodal to a, so it is negated before blending.
+        TF_AXIOM(_IsCloseQuat(blended[0].GetReal(), GfQuatf(1, 0, 0, 0),
+                              1e-6));
+        TF_AXIOM(_IsCloseQuat(blended[0].GetDual(), GfQuatf(0, 2, 0, 0),
+                              1e-6));
+        TF_AXIOM(_IsCloseQuat(blended[1].GetDual(), GfQuatf(0, 1, 0, 0),
+                              1e-6));
+        // The first influence decides which influences are negated.
+        TF_AXIOM(_IsCloseQuat(blended[2].GetReal(), GfQuatf(-1, 0, 0, 0),
+                              1e-6));
+        TF_AXIOM(_IsCloseQuat(blended[2].GetDual(), GfQuatf(0, -3, 0, 0),
+                              1e-6));
+
+        TfErrorMark mark;
+        TF_AXIOM(VtArrayDualQuatBlend(
+                     dqs, VtIntArray(3), VtFloatArray(3), 2).empty());
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+
+        const VtDualQuatfArray bad = VtArrayDualQuatBlend(
+            dqs, VtIntArray { 5 }, VtFloatArray { 1.0f }, 1);
+        TF_AXIOM(bad.size() == 1 && !mark.IsClean());
+        TF_AXIOM(_IsCloseQuat(bad[0].GetReal(), GfQuatf(1, 0, 0, 0), 1e-6));
+        TF_AXIOM(_IsCloseQuat(bad[0].GetDual(), zero, 1e-6));
+        mark.Clear();
+    }
+}
+
+static void testComparisons()
+{
+    const VtIntArray a = { 1, 5, 3, 7 };
+    const VtIntArray b = { 2, 5, 1, 7 };
+
+    TF_AXIOM(VtEqual(a, b) == VtBoolArray({ false, true, false, true }));
+    TF_AXIOM(VtNotEqual(a, b) == VtBoolArray({ true, false, true, false }));
+    TF_AXIOM(VtLess(a, b) == VtBoolArray({ true, false, false, false }));
+    TF_AXIOM(VtLessOrEqual(a, b) == VtBoolArray({ true, true, false, true }));
+    TF_AXIOM(VtGreater(a, b) == VtBoolArray({ false, false, true, false }));
+    TF_AXIOM(VtGreaterOrEqual(a, b) ==
+             VtBoolArray({ false, true, true, true }));
+
+    // Comparisons against a single value.
+    TF_AXIOM(VtGreater(a, 3) == VtBoolArray({ false, true, false, true }));
+    TF_AXIOM(VtGreater(3, a) == VtBoolArray({ true, false, false, false }));
+    TF_AXIOM(VtEqual(VtVec3fArray { GfVec3f(1), GfVec3f(2) }, GfVec3f(2)) ==
+             VtBoolArray({ false, true }));
+    TF_AXIOM(VtEqual(VtIntArray(), VtIntArray()).empty());
+
+    TfErrorMark mark;
+    TF_AXIOM(VtEqual(a, VtIntArray(3)).empty());
+    TF_AXIOM(!mark.IsClean());
+    mark.Clear();
+}
+
+static void testSelectCompress()
+{
+    const VtStringArray a = { "a", "b", "c", "d" };
+    const VtStringArray b = { "w", "x", "y", "z" };
+    const VtBoolArray mask = { true, false, false, true };
+
+    TF_AXIOM(VtArraySelect(mask, a, b) ==
+             VtStringArray({ "a", "x", "y", "d" }));
+    TF_AXIOM(VtArrayCompress(a, mask) == VtStringArray({ "a", "d" }));
+    TF_AXIOM(VtArrayCompress(a, VtBoolArray(4, false)).empty());
+    TF_AXIOM(VtArrayCompress(VtIntArray(), VtBoolArray()).empty());
+
+    // Selecting everything shares the source's data.
+    const VtStringArray all = VtArrayCompress(a, VtBoolArray(4, true));
+    TF_AXIOM(all.IsIdentical(a));
+
+    TfErrorMark mark;
+    TF_AXIOM(VtArraySelect(VtBoolArray(3), a, b).empty());
+    TF_AXIOM(!mark.IsClean());
+    mark.Clear();
+    TF_AXIOM(VtArrayCompress(a, VtBoolArray(5)).empty());
+    TF_AXIOM(!mark.IsClean());
+    mark.Clear();
+
+    // Large inputs, spanning several blocks.
+    VtDoubleArray values(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        values[i] = double(i);
+    }
+    TF_AXIOM(VtArrayCompress(values, VtEqual(values, values)).size() ==
+             LargeSize);
+
+    VtBoolArray every3rd(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        every3rd[i] = i % 3 == 0;
+    }
+    const VtDoubleArray compressed = VtArrayCompress(values, every3rd);
+    TF_AXIOM(compressed.size() == (LargeSize + 2) / 3);
+    for (size_t i = 0; i != compressed.size(); ++i) {
+        TF_AXIOM(compressed[i] == 3.0 * i);
+    }
+
+    const VtDoubleArray selected =
+        VtArraySelect(every3rd, values, VtDoubleArray(LargeSize, -1.0));
+    for (size_t i = 0; i != LargeSize; ++i) {
+        TF_AXIOM(selected[i] == (i % 3 == 0 ? double(i) : -1.0));
+    }
+}
+
+static void testIndexing()
+{
+    const VtStringArray values = { "a", "b", "c" };
+    const VtIntArray indices = { 2, 0, 0, 1, 2 };
+
+    // Gather.
+    TF_AXIOM(VtArrayGather(values, indices) ==
+             VtStringArray({ "c", "a", "a", "b", "c" }));
+    TF_AXIOM(VtArrayGather(values, VtIntArray()).empty());
+    {
+        TfErrorMark mark;
+        TF_AXIOM(VtArrayGather(values, VtIntArray { 0, 3 }).empty());
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+        TF_AXIOM(VtArrayGather(values, VtIntArray { -1 }).empty());
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+
+    // Scatter.
+    TF_AXIOM(VtArrayScatter(VtStringArray { "x", "y" }, VtIntArray { 2, 0 },
+                            values) == VtStringArray({ "y", "b", "x" }));
+    // Repeated indices take the last value.
+    TF_AXIOM(VtArrayScatter(VtStringArray { "x", "y", "z" },
+                            VtIntArray { 1, 1, 0 },
+                            values) == VtStringArray({ "z", "y", "c" }));
+    {
+        TfErrorMark mark;
+        const VtStringArray unchanged = VtArrayScatter(
+            VtStringArray { "x" }, VtIntArray { 3 }, values);
+        TF_AXIOM(unchanged.IsIdentical(values));
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+        TF_AXIOM(VtArrayScatter(VtStringArray { "x" }, VtIntArray(),
+                                values).IsIdentical(values));
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+
+    // Make indexed.
+    {
+        VtStringArray distinct;
+        VtIntArray idx;
+        VtArrayMakeIndexed(VtStringArray { "b", "a", "b", "b", "c" },
+                           &distinct, &idx);
+        TF_AXIOM(distinct == VtStringArray({ "b", "a", "c" }));
+        TF_AXIOM(idx == VtIntArray({ 0, 1, 0, 0, 2 }));
+
+        VtArrayMakeIndexed(VtStringArray(), &distinct, &idx);
+        TF_AXIOM(distinct.empty() && idx.empty());
+    }
+
+    // Round trip through large arrays.
+    VtFloatArray floats(1024);
+    for (size_t i = 0; i != floats.size(); ++i) {
+        floats[i] = float(i);
+    }
+    VtIntArray manyIndices(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        manyIndices[i] = (i * 7919) % floats.size();
+    }
+    const VtFloatArray dense = VtArrayGather(floats, manyIndices);
+    TF_AXIOM(dense.size() == LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        TF_AXIOM(dense[i] == float(manyIndices[i]));
+    }
+
+    VtFloatArray distinct;
+    VtIntArray idx;
+    VtArrayMakeIndexed(dense, &distinct, &idx);
+    TF_AXIOM(distinct.size() == floats.size());
+    TF_AXIOM(VtArrayGather(distinct, idx) == dense);
+
+    // Scatter a permutation back, in parallel.
+    VtIntArray permutation(LargeSize);
+    VtDoubleArray permuted(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        permutation[i] = (i * 7919) % LargeSize;
+        permuted[i] = permutation[i];
+    }
+    const VtDoubleArray scattered = VtArrayScatter(
+        permuted, permutation, VtDoubleArray(LargeSize));
+    for (size_t i = 0; i != LargeSize; ++i) {
+        TF_AXIOM(scattered[i] == double(i));
+    }
+
+    // Scatter sparsely into a larger array, with and without repeats.
+    const size_t numSparse = 50000;
+    VtIntArray sparseIndices(numSparse);
+    VtIntArray repeatedIndices(numSparse);
+    VtIntArray sparseValues(numSparse);
+    for (size_t i = 0; i != numSparse; ++i) {
+        sparseIndices[i] = (i * 7919) % (128 * numSparse);
+        repeatedIndices[i] = i % 3 ? sparseIndices[i] : sparseIndices[0];
+        sparseValues[i] = i;
+    }
+    const VtIntArray sparse = VtArrayScatter(
+        sparseValues, sparseIndices, VtIntArray(128 * numSparse));
+    const VtIntArray repeated = VtArrayScatter(
+        sparseValues, repeatedIndices, VtIntArray(128 * numSparse));
+    for (size_t i = 1; i != numSparse; ++i) {
+        TF_AXIOM(sparse[sparseIndices[i]] == int(i));
+        if (i % 3) {
+            TF_AXIOM(repeated[repeatedIndices[i]] == int(i));
+        }
+    }
+    TF_AXIOM(repeated[sparseIndices[0]] == int(numSparse - 2));
+}
+
+static void testConvert()
+{
+    VtDoubleArray doubles(LargeSize);
+    VtVec3dArray vecs(LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        doubles[i] = 0.5 * i;
+        vecs[i] = GfVec3d(i, -0.25 * i, 1.0);
+    }
+
+    const VtFloatArray floats = VtArrayConvert<float>(doubles);
+    const VtVec3fArray fvecs = VtArrayConvert<GfVec3f>(vecs);
+    TF_AXIOM(floats.size() == LargeSize && fvecs.size() == LargeSize);
+    for (size_t i = 0; i != LargeSize; ++i) {
+        TF_AXIOM(floats[i] == float(doubles[i]));
+        TF_AXIOM(fvecs[i] == GfVec3f(vecs[i]));
+    }
+    TF_AXIOM(VtArrayConvert<double>(floats) == doubles);
+
+    TF_AXIOM(VtArrayConvert<double>(VtIntArray { 1, -2, 3 }) ==
+             VtDoubleArray({ 1.0, -2.0, 3.0 }));
+    TF_AXIOM(VtArrayConvert<float>(VtDoubleArray()).empty());
+
+    // Element types without a flat representation.
+    const VtHalfArray halves = VtArrayConvert<GfHalf>(
+        VtFloatArray { 0.5f, -2.0f });
+    TF_AXIOM(VtArrayConvert<float>(halves) == VtFloatArray({ 0.5f, -2.0f }));
+
+    // Custom conversions.
+    const VtRange1dArray ranges = VtArrayConvert<GfRange1d>(
+        VtRange1fArray { GfRange1f(1.0f, 2.0f) },
+        [](GfRange1f const &r) {
+            return GfRange1d(r.GetMin(), r.GetMax());
+        });
+    TF_AXIOM(ranges == VtRange1dArray({ GfRange1d(1.0, 2.0) }));
+}
+
+int main(int argc, char *argv[])
+{
+    testSum();
+    testDot();
+    testMinMax();
+    testExtent();
+    testTransform();
+    testQuaternions();
+    testComparisons();
+    testSelectCompress();
+    testIndexing();
+    testConvert();
+
+    printf("Test SUCCEEDED\n");
+
+    return 0;
+}
@@ -0,0 +1,533 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/vt/pxr.h>
+#include <pxr/vt/array.h>
+#include <pxr/vt/arrayEdit.h>
+#include <pxr/vt/arrayEditBuilder.h>
+#include <pxr/vt/typeHeaders.h>
+#include <pxr/vt/types.h>
+#include <pxr/vt/value.h>
+
+#include <pxr/arch/demangle.h>
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/stopwatch.h>
+#include <pxr/tf/stringUtils.h>
+#include <pxr/tf/token.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+VT_NAMESPACE_USING_DIRECTIVE
+
+// Benchmarks for bulk VtArray operations.  Each benchmark checks its result
+// and prints the best time of several runs, so that regressions show up in
+// the test output.
+
+static const size_t NumElements = 4000000;
+static const int NumRuns = 5;
+
+// Total bytes requested from operator new, to measure the heap memory that
+// VtValues hold outside of their local storage.
+static std::atomic<size_t> _allocatedBytes(0);
+
+void *
+operator new(size_t size)
+{
+    _allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+// Return the best time in milliseconds of NumRuns calls to fn().
+template <class Fn>
+static double
+_Time(Fn const &fn)
+{
+    double best = 0.0;
+    for (int i = 0; i != NumRuns; ++i) {
+        TfStopwatch sw;
+        sw.Start();
+        fn();
+        sw.Stop();
+        if (i == 0 || sw.GetMilliseconds() < best) {
+            best = sw.GetMilliseconds();
+        }
+    }
+    return best;
+}
+
+static void
+_Report(std::string const &name, double ms)
+{
+    printf("%-48s %10.3f ms\n", name.c_str(), ms);
+}
+
+// Benchmark the registered VtValue cast from VtArray<From> to VtArray<To>.
+template <class From, class To>
+static void
+_BenchmarkCast()
+{
+    VtArray<From> src(NumElements);
+    for (size_t i = 0; i != NumElements; ++i) {
+        src[i] = From(float(i % 1024));
+    }
+    const VtValue srcVal(src);
+
+    VtValue result;
+    const double ms = _Time([&srcVal, &result]() {
+        result = VtValue::Cast<VtArray<To>>(srcVal);
+    });
+
+    TF_AXIOM(result.IsHolding<VtArray<To>>());
+    VtArray<To> const &dst = result.UncheckedGet<VtArray<To>>();
+    TF_AXIOM(dst.size() == NumElements);
+    TF_AXIOM(dst[NumElements - 1] == To(src[NumElements - 1]));
+
+    _Report("Cast " + ArchGetDemangled<VtArray<From>>() + " -> " +
+            ArchGetDemangled<VtArray<To>>(), ms);
+}
+
+template <class A, class B>
+static void
+_BenchmarkCasts()
+{
+    _BenchmarkCast<A, B>();
+    _BenchmarkCast<B, A>();
+}
+
+// Range casts, which fill each range with [i, i + 1] in every dimension.
+template <class From, class To>
+static void
+_BenchmarkRangeCast()
+{
+    typedef typename From::MinMaxType MinMax;
+    VtArray<From> src(NumElements);
+    for (size_t i = 0; i != NumElements; ++i) {
+        src[i] = From(MinMax(i % 1024), MinMax(i % 1024 + 1));
+    }
+    const VtValue srcVal(src);
+
+    VtValue result;
+    const double ms = _Time([&srcVal, &result]() {
+        result = VtValue::Cast<VtArray<To>>(srcVal);
+    });
+
+    TF_AXIOM(result.IsHolding<VtArray<To>>());
+    TF_AXIOM(result.UncheckedGet<VtArray<To>>().size() == NumElements);
+
+    _Report("Cast " + ArchGetDemangled<VtArray<From>>() + " -> " +
+            ArchGetDemangled<VtArray<To>>(), ms);
+}
+
+template <class A, class B>
+static void
+_BenchmarkRangeCasts()
+{
+    _BenchmarkRangeCast<A, B>();
+    _BenchmarkRangeCast<B, A>();
+}
+
+static void
+benchmarkArrayCasts()
+{
+    // Every cast registered by _RegisterArrayCasts() and
+    // _RegisterRangeArrayCasts() in types.cpp.
+    _BenchmarkCasts<GfHalf, float>();
+    _BenchmarkCasts<GfHalf, double>();
+    _BenchmarkCasts<float, double>();
+    _BenchmarkCasts<GfVec2h, GfVec2f>();
+    _BenchmarkCasts<GfVec2h, GfVec2d>();
+    _BenchmarkCasts<GfVec2f, GfVec2d>();
+    _BenchmarkCasts<GfVec3h, GfVec3f>();
+    _BenchmarkCasts<GfVec3h, GfVec3d>();
+    _BenchmarkCasts<GfVec3f, GfVec3d>();
+    _BenchmarkCasts<GfVec4h, GfVec4f>();
+    _BenchmarkCasts<GfVec4h, GfVec4d>();
+    _BenchmarkCasts<GfVec4f, GfVec4d>();
+
+    _BenchmarkRangeCasts<GfRange1f, GfRange1d>();
+    _BenchmarkRangeCasts<GfRange2f, GfRange2d>();
+    _BenchmarkRangeCasts<GfRange3f, GfRange3d>();
+}
+
+// Cast many scalar values between known types, as attribute value resolution
+// does.
+static void
+benchmarkValueCasts()
+{
+    const size_t numValues = NumElements / 4;
+
+    std::vector<VtValue> ints(numValues), vecs(numValues);
+    for (size_t i = 0; i != numValues; ++i) {
+        ints[i] = static_cast<int>(i);
+        vecs[i] = GfVec3f(static_cast<float>(i));
+    }
+
+    double sum = 0.0;
+    const double intMs = _Time([&ints, &sum]() {
+        sum = 0.0;
+        for (VtValue const &value: ints) {
+            sum += VtValue::Cast<double>(value).UncheckedGet<double>();
+        }
+    });
+    TF_AXIOM(sum == 0.5 * numValues * (numValues - 1));
+
+    std::vector<VtValue> doubles(numValues);
+    const double batchMs = _Time([&ints, &doubles]() {
+        VtValue::CastBatch(ints, typeid(double), doubles);
+    });
+    TF_AXIOM(doubles.back() == static_cast<double>(numValues - 1));
+
+    const double vecMs = _Time([&vecs, &sum]() {
+        sum = 0.0;
+        for (VtValue const &value: vecs) {
+            sum += VtValue::Cast<GfVec3d>(value).UncheckedGet<GfVec3d>()[0];
+        }
+    });
+    TF_AXIOM(sum == 0.5 * numValues * (numValues - 1));
+
+    size_t numCastable = 0;
+    const double canCastMs = _Time([&vecs, &numCastable]() {
+        numCastable = 0;
+        for (VtValue const &value: vecs) {
+            numCastable += value.CanCast<GfVec3d>();
+        }
+    });
+    TF_AXIOM(numCastable == numValues);
+
+    // There is no chain of casts from GfVec3f to GfVec3i, so after the first
+    // check this measures finding the cached miss.
+    VtValue::SetTransitiveCastsEnabled(true);
+    const double missMs = _Time([&vecs, &numCastable]() {
+        numCastable = 0;
+        for (VtValue const &value: vecs) {
+            numCastable += value.CanCast<GfVec3i>();
+        }
+    });
+    VtValue::SetTransitiveCastsEnabled(false);
+    TF_AXIOM(numCastable == 0);
+
+    _Report("Cast " + TfStringify(numValues) + " int values to double",
+            intMs);
+    _Report("Batch cast " + TfStringify(numValues) + " int values to double",
+            batchMs);
+    _Report("Cast " + TfStringify(numValues) + " GfVec3f values to GfVec3d",
+            vecMs);
+    _Report("Check " + TfStringify(numValues) + " casts", canCastMs);
+    _Report("Check " + TfStringify(numValues) + " transitive casts", missMs);
+}
+
+// Return a VtValue holding element \p i of a mix of the types that scene
+// description commonly holds.
+static VtValue
+_MakeMixedValue(size_t i)
+{
+    static const TfToken token("token");
+    const float f = static_cast<float>(i);
+    const double d = static_cast<double>(i);
+    switch (i % 12) {
+    case 0: return VtValue(static_cast<int>(i));
+    case 1: return VtValue(f);
+    case 2: return VtValue(d);
+    case 3: return VtValue(token);
+    case 4: return VtValue(GfVec2f(f));
+    case 5: return VtValue(GfVec3f(f));
+    case 6: return VtValue(GfVec4f(f));
+    case 7: return VtValue(GfVec3d(d));
+    case 8: return VtValue(GfQuatf(f));
+    case 9: return VtValue(GfRange1d(d, d + 1.0));
+    case 10: return VtValue(GfMatrix4d(d));
+    default: return VtValue(VtFloatArray(4, f));
+    }
+}
+
+// Construct, copy and read VtValues holding a mix of types, and report the
+// memory each value uses, including any heap allocation.  Which of these
+// types VtValue holds locally depends on VT_VALUE_LOCAL_STORAGE_SIZE.
+static void
+benchmarkValueTypeMix()
+{
+    const size_t numValues = NumElements / 4;
+
+    std::vector<VtValue> values, copies;
+    size_t heapBytes = 0;
+    const double constructMs = _Time([&values, &heapBytes]() {
+        values.clear();
+        values.shrink_to_fit();
+        const size_t start = _allocatedBytes.load();
+        values.reserve(numValues);
+        for (size_t i = 0; i != numValues; ++i) {
+            values.push_back(_MakeMixedValue(i));
+        }
+        heapBytes = _allocatedBytes.load() - start -
+            numValues * sizeof(VtValue);
+    });
+
+    const double copyMs = _Time([&values, &copies]() {
+        copies = values;
+    });
+    TF_AXIOM(copies == values);
+
+    double sum = 0.0;
+    const double readMs = _Time([&values, &sum]() {
+        sum = 0.0;
+        for (VtValue const &value: values) {
+            if (value.IsHolding<GfVec3f>()) {
+                sum += value.UncheckedGet<GfVec3f>()[0];
+            } else if (value.IsHolding<GfVec3d>()) {
+                sum += value.UncheckedGet<GfVec3d>()[0];
+            } else if (value.IsHolding<double>()) {
+                sum += value.UncheckedGet<double>();
+            }
+        }
+    });
+    TF_AXIOM(sum > 0.0);
+
+    const double bytesPerValue =
+        sizeof(VtValue) + static_cast<double>(heapBytes) / numValues;
+    _Report("Construct " + TfStringify(numValues) + " mixed values, " +
+            TfStringPrintf("%.1f", bytesPerValue) + " bytes each",
+            constructMs);
+    _Report("Copy " + TfStringify(numValues) + " mixed values", copyMs);
+    _Report("Read " + TfStringify(numValues) + " mixed values", readMs);
+}
+
+// Apply an edit with many scattered inserts and erases to a large array.
+static void
+benchmarkArrayEditApply()
+{
+    const int64_t numEdits = 1000;
+    const int64_t stride = NumElements / numEdits;
+
+    VtIntArrayEditBuilder builder;
+    for (int64_t i = 0; i != numEdits; ++i) {
+        builder.Insert(-1, i * stride);
+        builder.EraseRef(i * stride + stride / 2);
+    }
+    builder.Append(-2);
+    const VtIntArrayEdit edit = builder.FinalizeAndReset();
+
+    VtIntArray src(NumElements);
+    for (size_t i = 0; i != NumElements; ++i) {
+        src[i] = static_cast<int>(i);
+    }
+
+    VtIntArray result;
+    const double ms = _Time([&edit, &src, &result]() {
+        result = edit.ComposeOver(src).GetDenseArray();
+    });
+
+    TF_AXIOM(result.size() == NumElements + 1);
+    TF_AXIOM(result[0] == -1 && result[1] == 0);
+    TF_AXIOM(result[NumElements] == -2);
+
+    _Report("Apply " + TfStringify(2 * numEdits + 1) + " inserts/erases", ms);
+}
+
+// Apply an edit with many inserts at scattered positions, each of which
+// splits a run of the layout computed for the result.
+static void
+benchmarkArrayEditScatteredInserts()
+{
+    const int64_t numInserts = 100000;
+
+    VtIntArrayEditBuilder builder;
+    for (int64_t i = 0; i != numInserts; ++i) {
+        builder.Insert(-1, (i * 7919) % (NumElements + i));
+    }
+    const VtIntArrayEdit edit = builder.FinalizeAndReset();
+
+    VtIntArray src(NumElements);
+    for (size_t i = 0; i != NumElements; ++i) {
+        src[i] = static_cast<int>(i);
+    }
+
+    VtIntArray result;
+    const double ms = _Time([&edit, &src, &result]() {
+        result = edit.ComposeOver(src).GetDenseArray();
+    });
+
+    TF_AXIOM(result.size() == NumElements + numInserts);
+    TF_AXIOM(std::count(result.begin(), result.end(), -1) == numInserts);
+
+    _Report("Apply " + TfStringify(numInserts) + " scattered inserts", ms);
+}
+
+// Apply an edit with many scattered writes to a large array.
+static void
+benchmarkArrayEditWrites()
+{
+    const size_t numWrites = NumElements / 4;
+
+    std::vector<int> elems(numWrites);
+    std::vector<int64_t> indexes(numWrites);
+    for (size_t i = 0; i != numWrites; ++i) {
+        elems[i] = -static_cast<int>(i % 1024);
+        indexes[i] = (i * 7919) % NumElements;
+    }
+    const VtIntArrayEdit edit =
+        VtIntArrayEditBuilder().WriteMany(elems, indexes).FinalizeAndReset();
+
+    VtIntArray src(NumElements);
+    for (size_t i = 0; i != NumElements; ++i) {
+        src[i] = static_cast<int>(i);
+    }
+
+    VtIntArray result;
+    const double ms = _Time([&edit, &src, &result]() {
+        result = edit.ComposeOver(src).GetDenseArray();
+    });
+
+    TF_AXIOM(result.size() == NumElements);
+    TF_AXIOM(result[indexes[numWrites - 1]] == elems[numWrites - 1]);
+
+    _Report("Apply " + TfStringify(numWrites) + " writes", ms);
+}
+
+// Build an edit with many writes of distinct values, one call at a time and
+// in bulk.
+static void
+benchmarkArrayEditBuilder()
+{
+    const size_t numWrites = 200000;
+
+    std::vector<int> elems(numWrites);
+    std::vector<int64_t> indexes(numWrites);
+    for (size_t i = 0; i != numWrites; ++i) {
+        elems[i] = static_cast<int>(i);
+        indexes[i] = 3 * i;
+    }
+
+    VtIntArrayEdit single, bulk;
+    const double singleMs = _Time([&elems, &indexes, &single]() {
+        VtIntArrayEditBuilder builder;
+        for (size_t i = 0; i != elems.size(); ++i) {
+            builder.Write(elems[i], indexes[i]);
+        }
+        single = builder.FinalizeAndReset();
+    });
+    const double bulkMs = _Time([&elems, &indexes, &bulk]() {
+        bulk = VtIntArrayEditBuilder()
+            .WriteMany(elems, indexes).FinalizeAndReset();
+    });
+    TF_AXIOM(single == bulk);
+
+    _Report("Build " + TfStringify(numWrites) + " writes", singleMs);
+    _Report("Build " + TfStringify(numWrites) + " writes in bulk", bulkMs);
+}
+
+// Build an edit with many writes of distinct values in chunks, with one
+// builder per chunk, and merge them.
+static void
+benchmarkArrayEditMerge()
+{
+    const size_t numWrites = 800000;
+    const size_t numChunks = 16;
+    const size_t chunkSize = numWrites / numChunks;
+
+    VtIntArrayEdit merged;
+    const double ms = _Time([&merged]() {
+        std::vector<VtIntArrayEditBuilder> builders(numChunks);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, numChunks),
+            [&builders](tbb::blocked_range<size_t> const &r) {
+                for (size_t c = r.begin(); c != r.end(); ++c) {
+                    for (size_t i = c * chunkSize;
+                         i != (c + 1) * chunkSize; ++i) {
+                        builders[c].Write(static_cast<int>(i), 3 * i);
+                    }
+                }
+            });
+        merged = VtIntArrayEditBuilder::MergeAndReset(builders);
+    });
+
+    const VtIntArray result =
+        merged.ComposeOver(VtIntArray(3 * numWrites)).GetDenseArray();
+    TF_AXIOM(result[3 * (numWrites - 1)] == static_cast<int>(numWrites - 1));
+
+    _Report("Build " + TfStringify(numWrites) + " writes in " +
+            TfStringify(numChunks) + " builders", ms);
+}
+
+// Encode and decode an edit with many writes and inserts in the raw and
+// compact serialization formats, and report their sizes.
+static void
+benchmarkArrayEditSerialization()
+{
+    const int64_t numEdits = 100000;
+    const int64_t stride = NumElements / numEdits;
+
+    VtIntArrayEditBuilder builder;
+    for (int64_t i = 0; i != numEdits; ++i) {
+        builder.Write(static_cast<int>(i), i * stride);
+        builder.Insert(static_cast<int>(i), i * stride + 1);
+    }
+    const VtIntArrayEdit edit = builder.FinalizeAndReset();
+
+    VtIntArray literals;
+    std::vector<int64_t> indexes;
+    std::vector<uint8_t> bytes;
+    VtIntArrayEditBuilder::GetSerializationData(edit, &literals, &indexes);
+
+    VtIntArrayEdit result;
+    const double rawMs = _Time([&edit, &literals, &indexes, &result]() {
+        VtIntArrayEditBuilder::GetSerializationData(
+            edit, &literals, &indexes);
+        result = VtIntArrayEditBuilder::CreateFromSerializationData(
+            literals, indexes, false);
+    });
+    TF_AXIOM(result == edit);
+
+    const double compactMs = _Time([&edit, &literals, &bytes, &result]() {
+        VtIntArrayEditBuilder::GetCompactSerializationData(
+            edit, &literals, &bytes);
+        result = VtIntArrayEditBuilder::CreateFromCompactSerializationData(
+            literals, bytes, false);
+    });
+    TF_AXIOM(result == edit);
+    TF_AXIOM(bytes.size() < indexes.size() * sizeof(int64_t));
+
+    _Report("Serialize " + TfStringify(2 * numEdits) + " edits, " +
+            TfStringify(indexes.size() * sizeof(int64_t)) + " bytes",
+            rawMs);
+    _Report("Serialize compact " + TfStringify(2 * numEdits) + " edits, " +
+            TfStringify(bytes.size()) + " bytes", compactMs);
+}
+
+int main(int argc, char *argv[])
+{
+    benchmarkArrayCasts();
+    benchmarkValueCasts();
+    benchmarkValueTypeMix();
+    benchmarkArrayEditApply();
+    benchmarkArrayEditScatteredInserts();
+    benchmarkArrayEditWrites();
+    benchmarkArrayEditBuilder();
+    benchmarkArrayEditMerge();
+    benchmarkArrayEditSerialization();
+
+    printf("Test SUCCEEDED\n");
+
+    return 0;
+}
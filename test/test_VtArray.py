@@ -11,7 +11,7 @@ from __future__ import division
 import array
 import unittest
 import sys, math
-from pxr import Gf, Vt
+from pxr import Gf, Tf, Vt
 
 class TestVtArray(unittest.TestCase):
 
@@ -326,6 +326,11 @@ class TestVtArray(unittest.TestCase):
             a /= 5.0
             self.assertEqual(a, ArrayType([0.2, 1, 2]))
 
+            self.assertEqual(ArrayType([1, 5, 10]) / (5, 5, 10),
+                             ArrayType([0.2, 1, 1]))
+            self.assertEqual([5, 5, 10] / ArrayType([1, 5, 10]),
+                             ArrayType([5, 1, 1]))
+
         _TestDivision(Vt.FloatArray)
         _TestDivision(Vt.DoubleArray)
 
@@ -365,6 +370,155 @@ class TestVtArray(unittest.TestCase):
         vtArrayFromBuffer = Vt.UCharArray.FromBuffer(largePyBuffer)
         self.assertEqual(len(vtArrayFromBuffer), 2500000000)
 
+    def test_Transform(self):
+        m = Gf.Matrix4d().SetScale(2.0).SetTranslateOnly(Gf.Vec3d(1, 2, 3))
+        for ArrayType, VecType in ((Vt.Vec3fArray, Gf.Vec3f),
+                                   (Vt.Vec3dArray, Gf.Vec3d)):
+            vecs = ArrayType([VecType(1, 0, 0), VecType(0, 1, 2)])
+
+            points = Vt.ArrayTransformPoints(vecs, m)
+            self.assertIsInstance(points, ArrayType)
+            self.assertEqual(points,
+                ArrayType([VecType(3, 2, 3), VecType(1, 4, 7)]))
+            self.assertEqual(
+                Vt.ArrayTransformPoints(vecs, m, accumulateInDouble=False),
+                points)
+
+            self.assertEqual(Vt.ArrayTransformDirections(vecs, m),
+                ArrayType([VecType(2, 0, 0), VecType(0, 2, 4)]))
+            self.assertEqual(Vt.ArrayTransformNormals(vecs, m),
+                ArrayType([VecType(0.5, 0, 0), VecType(0, 0.5, 1)]))
+
+            mats = Vt.Matrix4dArray([m, Gf.Matrix4d(1)])
+            self.assertEqual(Vt.ArrayTransformPoints(vecs, mats),
+                ArrayType([VecType(3, 2, 3), VecType(0, 1, 2)]))
+            self.assertEqual(Vt.ArrayTransformDirections(vecs, mats),
+                ArrayType([VecType(2, 0, 0), VecType(0, 1, 2)]))
+            self.assertEqual(Vt.ArrayTransformNormals(vecs, mats),
+                ArrayType([VecType(0.5, 0, 0), VecType(0, 1, 2)]))
+
+            # The number of matrices must match the number of elements.
+            with self.assertRaises(Tf.ErrorException):
+                Vt.ArrayTransformPoints(vecs, Vt.Matrix4dArray(3))
+
+    def test_Quaternions(self):
+        s = math.sqrt(0.5)
+        for ArrayType, QuatType, VecArrayType, VecType in (
+                (Vt.QuatfArray, Gf.Quatf, Vt.Vec3fArray, Gf.Vec3f),
+                (Vt.QuatdArray, Gf.Quatd, Vt.Vec3dArray, Gf.Vec3d)):
+            rotZ = QuatType(s, 0, 0, s)
+            quats = ArrayType([QuatType(2, 0, 0, 0), QuatType(0, 3, 0, 4)])
+            self.assertEqual(Vt.ArrayQuatNormalize(quats),
+                ArrayType([QuatType(1, 0, 0, 0), QuatType(0, 0.6, 0, 0.8)]))
+
+            self.assertEqual(
+                Vt.ArrayQuatMultiply(ArrayType([QuatType(0, 1, 0, 0)]),
+                                     ArrayType([QuatType(0, 0, 1, 0)])),
+                ArrayType([QuatType(0, 0, 0, 1)]))
+
+            halfway = Vt.ArrayQuatSlerp(
+                0.5, ArrayType([QuatType(1, 0, 0, 0)]), ArrayType([rotZ]))
+            self.assertTrue(Gf.IsClose(halfway[0].GetReal(),
+                                       math.cos(math.pi / 8), 1e-6))
+
+            rotated = Vt.ArrayQuatRotate(
+                ArrayType([rotZ]), VecArrayType([VecType(1, 0, 0)]))
+            self.assertIsInstance(rotated, VecArrayType)
+            self.assertTrue(Gf.IsClose(rotated[0], VecType(0, 1, 0), 1e-6))
+
+            with self.assertRaises(Tf.ErrorException):
+                Vt.ArrayQuatMultiply(ArrayType(2), ArrayType(3))
+
+        dqs = Vt.DualQuatdArray([
+            Gf.DualQuatd(Gf.Quatd(1, 0, 0, 0), Gf.Quatd(0, 1, 0, 0)),
+            Gf.DualQuatd(Gf.Quatd(1, 0, 0, 0), Gf.Quatd(0, 3, 0, 0))])
+        blended = Vt.ArrayDualQuatBlend(
+            dqs, Vt.IntArray([0, 1]), Vt.FloatArray([0.5, 0.5]), 2)
+        self.assertEqual(blended, Vt.DualQuatdArray([
+            Gf.DualQuatd(Gf.Quatd(1, 0, 0, 0), Gf.Quatd(0, 2, 0, 0))]))
+
+    def test_Comparisons(self):
+        a = Vt.IntArray([1, 5, 3, 7])
+        b = Vt.IntArray([2, 5, 1, 7])
+        self.assertEqual(Vt.Equal(a, b), Vt.BoolArray([0, 1, 0, 1]))
+        self.assertEqual(Vt.NotEqual(a, b), Vt.BoolArray([1, 0, 1, 0]))
+        self.assertEqual(Vt.Less(a, b), Vt.BoolArray([1, 0, 0, 0]))
+        self.assertEqual(Vt.LessOrEqual(a, b), Vt.BoolArray([1, 1, 0, 1]))
+        self.assertEqual(Vt.Greater(a, 3), Vt.BoolArray([0, 1, 0, 1]))
+        self.assertEqual(Vt.GreaterOrEqual(3, a), Vt.BoolArray([1, 0, 1, 0]))
+        self.assertEqual(Vt.Equal(a, (1, 2, 3, 4)), Vt.BoolArray([1, 0, 1, 0]))
+        self.assertEqual(Vt.Less([0, 9, 0, 9], a), Vt.BoolArray([1, 0, 1, 0]))
+
+        v = Vt.Vec3fArray([Gf.Vec3f(1), Gf.Vec3f(2)])
+        self.assertEqual(Vt.Equal(v, Gf.Vec3f(2)), Vt.BoolArray([0, 1]))
+
+        with self.assertRaises(Tf.ErrorException):
+            Vt.Equal(a, Vt.IntArray(3))
+        with self.assertRaises(ValueError):
+            Vt.Equal(a, (1, 2))
+
+    def test_SelectCompress(self):
+        a = Vt.StringArray(['a', 'b', 'c', 'd'])
+        b = Vt.StringArray(['w', 'x', 'y', 'z'])
+        mask = Vt.BoolArray([True, False, False, True])
+        self.assertEqual(Vt.ArraySelect(mask, a, b),
+                         Vt.StringArray(['a', 'x', 'y', 'd']))
+        self.assertEqual(Vt.ArrayCompress(a, mask),
+                         Vt.StringArray(['a', 'd']))
+
+        d = Vt.DoubleArray([0.5, -1.0, 2.0])
+        self.assertEqual(Vt.ArrayCompress(d, Vt.Greater(d, 0.0)),
+                         Vt.DoubleArray([0.5, 2.0]))
+
+        with self.assertRaises(Tf.ErrorException):
+            Vt.ArrayCompress(a, Vt.BoolArray(3))
+
+    def test_Indexing(self):
+        values = Vt.StringArray(['a', 'b', 'c'])
+        indices = Vt.IntArray([2, 0, 0, 1, 2])
+        dense = Vt.ArrayGather(values, indices)
+        self.assertEqual(dense, Vt.StringArray(['c', 'a', 'a', 'b', 'c']))
+
+        distinct, idx = Vt.ArrayMakeIndexed(dense)
+        self.assertEqual(distinct, Vt.StringArray(['c', 'a', 'b']))
+        self.assertEqual(idx, Vt.IntArray([0, 1, 1, 2, 0]))
+        self.assertEqual(Vt.ArrayGather(distinct, idx), dense)
+
+        self.assertEqual(
+            Vt.ArrayScatter(Vt.FloatArray([1, 2]), Vt.IntArray([2, 0]),
+                            Vt.FloatArray(3)),
+            Vt.FloatArray([2, 0, 1]))
+
+        with self.assertRaises(Tf.ErrorException):
+            Vt.ArrayGather(values, Vt.IntArray([3]))
+
+    def test_Reductions(self):
+        a = Vt.FloatArray([3, -1, 4, 1, 5])
+        self.assertEqual(Vt.ArraySum(a), 12)
+        self.assertEqual(Vt.ArraySum(a, deterministic=True), 12)
+        self.assertEqual(Vt.ArrayMin(a), -1)
+        self.assertEqual(Vt.ArrayMax(a), 5)
+        self.assertEqual(Vt.ArrayDot(a, a), 52)
+
+        v = Vt.Vec3dArray([Gf.Vec3d(1, 5, 3), Gf.Vec3d(4, 2, 6)])
+        self.assertEqual(Vt.ArraySum(v), Gf.Vec3d(5, 7, 9))
+        self.assertEqual(Vt.ArrayMin(v), Gf.Vec3d(1, 2, 3))
+        self.assertEqual(Vt.ArrayMax(v), Gf.Vec3d(4, 5, 6))
+        self.assertEqual(Vt.ArrayDot(v, v), 91)
+
+        with self.assertRaises(ValueError):
+            Vt.ArrayMin(Vt.IntArray())
+        with self.assertRaises(Tf.ErrorException):
+            Vt.ArrayDot(a, Vt.FloatArray(2))
+
+        # Large enough to run without holding the GIL.
+        n = 100000
+        big = Vt.IntArray(n, 2)
+        self.assertEqual(Vt.ArraySum(big), 2 * n)
+        self.assertEqual(big + big, Vt.IntArray(n, 4))
+        self.assertEqual(3 * big, Vt.IntArray(n, 6))
+        self.assertEqual(-big, Vt.IntArray(n, -2))
+        self.assertEqual(Vt.DoubleArray(n, 3) / 2.0, Vt.DoubleArray(n, 1.5))
 
 if __name__ == '__main__':
     unittest.main()
@@ -89,5 +89,56 @@ class TestVtArrayEdit(unittest.TestCase):
         self.assertEqual(size7Fill3.ComposeOver([]), [3]*7)
         self.assertEqual(size7Fill3.ComposeOver([9]*27), [9]*7)
 
+    def test_Ranges(self):
+        builder = Vt.IntArrayEditBuilder()
+        one7 = [0,1,2,3,4,5,6,7]
+        edit = (builder
+                .WriteRange(Vt.IntArray([9,9]), -2)
+                .InsertRange(Vt.IntArray([5,5,5]), 0)
+                .EraseRange(3, 4)
+                .FinalizeAndReset())
+        self.assertEqual(edit.ComposeOver(one7), [5,5,5,4,5,9,9])
+
+        edit = (builder
+                .WriteRefRange(0, 1, 3)
+                .InsertRefRange(-2, 8, 2)
+                .FinalizeAndReset())
+        self.assertEqual(edit.ComposeOver(one7), [0,0,1,2,4,5,6,7,6,7])
+
+    def test_ComposeStack(self):
+        builder = Vt.IntArrayEditBuilder()
+        append = builder.Append(7).FinalizeAndReset()
+        prepend = builder.Prepend(5).FinalizeAndReset()
+        dense = Vt.IntArrayEdit(Vt.IntArray([1,2]))
+
+        self.assertTrue(Vt.IntArrayEdit.ComposeStack([]).IsIdentity())
+        self.assertEqual(
+            Vt.IntArrayEdit.ComposeStack([append, prepend, dense, append]),
+            append.ComposeOver(prepend.ComposeOver(dense)))
+        self.assertEqual(
+            Vt.IntArrayEdit.ComposeStack(
+                [append, prepend, append]).ComposeOver(Vt.IntArray([0])),
+            [5,0,7,7])
+
+    def test_Diff(self):
+        old = Vt.IntArray(range(10))
+        new = Vt.IntArray([0,1,-1,2,3,4,5,8,9])
+        diff = Vt.IntArrayEditBuilder.Diff(old, new)
+        self.assertIsInstance(diff, Vt.IntArrayEdit)
+        self.assertEqual(diff.ComposeOver(old), new)
+        self.assertTrue(Vt.IntArrayEditBuilder.Diff(old, old).IsIdentity())
+        # Dense edits unbox to arrays.
+        self.assertEqual(
+            Vt.IntArrayEditBuilder.Diff(old, new, maxChanges=1), new)
+
+    def test_ApplyWithInverse(self):
+        array = Vt.IntArray(range(10))
+        edit = (Vt.IntArrayEditBuilder()
+                .Write(-1, 3).EraseRef(5).Append(-2).FinalizeAndReset())
+        result, inverse = edit.ApplyWithInverse(array)
+        self.assertEqual(result, edit.ComposeOver(array))
+        self.assertIsInstance(inverse, Vt.IntArrayEdit)
+        self.assertEqual(inverse.ComposeOver(result), array)
+
 if __name__ == '__main__':
     unittest.main()